@@ -21,9 +21,6 @@
 
 extern "C"{
 
-  bool True=true;
-  bool False=false;
-  
   Gomu::Type types[]={
     TYPE_SENTINEL
   };
@@ -62,8 +59,8 @@ extern "C"{
 
 
   Gomu::Module::Symbol symbols[]={
-    {"true","Boolean",(void*)&True},
-    {"false","Boolean",(void*)&False},
+    {"true","Boolean",(void*)&Gomu::boolean_true},
+    {"false","Boolean",(void*)&Gomu::boolean_false},
     SYMB_SENTINEL
   };
 }
@@ -19,15 +19,35 @@
 
 #include "integer.hpp"
 
+//---------------------------------
+// integer_fmpz_op(op,void*,void*)
+//---------------------------------
+
+//! Return op(a,b) computed on fmpz, used when an integer is not immediate
+//! or when the result may overflow
+static void* integer_fmpz_op(void (*op)(fmpz*,const fmpz*,const fmpz*),void* a,void* b){
+  fmpz x,y;
+  fmpz_init(&x);
+  fmpz_init(&y);
+  get_fmpz(&x,a);
+  get_fmpz(&y,b);
+  fmpz* res=new fmpz;
+  fmpz_init(res);
+  op(res,&x,&y);
+  fmpz_clear(&x);
+  fmpz_clear(&y);
+  return to_integer_fmpz(res);
+}
+
 //------------------------------
 // Integer add(Integer,Integer)
 //------------------------------
 
 void* integer_add(void* a,void* b){
-  fmpz* res=new fmpz;
-  fmpz_init(res);
-  fmpz_add(res,(fmpz*)a,(fmpz*)b);
-  return (void*)res;
+  //The sum of two immediate integers fits in a slong
+  if(is_small_integer(a) and is_small_integer(b))
+    return to_integer(get_small_integer(a)+get_small_integer(b));
+  return integer_fmpz_op(fmpz_add,a,b);
 }
 
 //------------------------------
@@ -35,10 +55,11 @@ void* integer_add(void* a,void* b){
 //------------------------------
 
 void* integer_mul(void* a,void* b){
-  fmpz* res=new fmpz;
-  fmpz_init(res);
-  fmpz_mul(res,(fmpz*)a,(fmpz*)b);
-  return (void*)res;
+  slong res;
+  if(is_small_integer(a) and is_small_integer(b) and
+     not __builtin_mul_overflow(get_small_integer(a),get_small_integer(b),&res))
+    return to_integer(res);
+  return integer_fmpz_op(fmpz_mul,a,b);
 }
 
 //-------------------------
@@ -46,10 +67,11 @@ void* integer_mul(void* a,void* b){
 //-------------------------
 
 void* integer_negate(void* a){
+  if(is_small_integer(a)) return to_integer(-get_small_integer(a));
   fmpz* res=new fmpz;
   fmpz_init(res);
   fmpz_neg(res,(fmpz*)a);
-  return (void*)res;
+  return to_integer_fmpz(res);
 }
 
 //------------------------------
@@ -57,10 +79,18 @@ void* integer_negate(void* a){
 //------------------------------
 
 void* integer_quo(void* a,void* b){
-  fmpz* res=new fmpz;
-  fmpz_init(res);
-  fmpz_fdiv_q(res,(fmpz*)a,(fmpz*)b);
-  return (void*)res;
+  //Zero divisors and small_integer_min/-1 are left to fmpz
+  if(is_small_integer(a) and is_small_integer(b)){
+    slong x=get_small_integer(a);
+    slong y=get_small_integer(b);
+    if(y!=0 and not (x==small_integer_min and y==-1)){
+      //Round towards minus infinity as fmpz_fdiv_q
+      slong q=x/y;
+      if(x%y!=0 and ((x<0)!=(y<0))) --q;
+      return to_integer(q);
+    }
+  }
+  return integer_fmpz_op(fmpz_fdiv_q,a,b);
 }
 
 //------------------------------
@@ -68,10 +98,18 @@ void* integer_quo(void* a,void* b){
 //------------------------------
 
 void* integer_rem(void* a,void* b){
-  fmpz* res=new fmpz;
-  fmpz_init(res);
-  fmpz_fdiv_r(res,(fmpz*)a,(fmpz*)b);
-  return (void*)res;
+  //Zero divisors and small_integer_min/-1 are left to fmpz
+  if(is_small_integer(a) and is_small_integer(b)){
+    slong x=get_small_integer(a);
+    slong y=get_small_integer(b);
+    if(y!=0 and not (x==small_integer_min and y==-1)){
+      //The remainder has the sign of y as for fmpz_fdiv_r
+      slong r=x%y;
+      if(r!=0 and ((r<0)!=(y<0))) r+=y;
+      return to_integer(r);
+    }
+  }
+  return integer_fmpz_op(fmpz_fdiv_r,a,b);
 }
 
 //------------------------------
@@ -79,8 +117,7 @@ void* integer_rem(void* a,void* b){
 //------------------------------
 
 void* integer_sub(void* a,void* b){
-  fmpz* res=new fmpz;
-  fmpz_init(res);
-  fmpz_sub(res,(fmpz*)a,(fmpz*)b);
-  return (void*)res;
+  if(is_small_integer(a) and is_small_integer(b))
+    return to_integer(get_small_integer(a)-get_small_integer(b));
+  return integer_fmpz_op(fmpz_sub,a,b);
 }
@@ -18,6 +18,8 @@
  */
 
 #include "braids.hpp"
+#include "conjugacy.hpp"
+#include "lattice.hpp"
 #include "init.hpp"
 
 //******************
@@ -26,6 +28,8 @@
 
 MonoidFamily ArtinA_mf("Artin A-type",ArtinA_disp,ArtinA_gnum,ArtinA_rank);
 MonoidFamily DualA_mf("Dual A-type",DualA_disp,DualA_gnum,DualA_rank);
+WordProblem ArtinA_word_problem=ArtinA_reversing_equivalent;
+atomic<bool> ArtinA_fingerprint_filter(true);
 
 //***********************
 //* Auxiliary functions *
@@ -37,52 +41,27 @@ MonoidFamily DualA_mf("Dual A-type",DualA_disp,DualA_gnum,DualA_rank);
 
 void braids_init(){
   ArtinA_mf.data=(void*)type_ArtinWordA;
-  ArtinA_mf.set_left_complement(&ArtinA_left_sc);
-  ArtinA_mf.set_right_complement(&ArtinA_right_sc);
+  ArtinA_mf.set_left_reversing(new ReversingEngine<LeftDirection,StaticComplement<ArtinA_left_sc>>(&ArtinA_left_sc));
+  ArtinA_mf.set_right_reversing(new ReversingEngine<RightDirection,StaticComplement<ArtinA_right_sc>>(&ArtinA_right_sc));
   ArtinA_mf.set_ranked_phi_germ(&ArtinA_rpg);
   ArtinA_mf.set_ranked_garside_word_factory(&ArtinA_rgwf);
+  ArtinA_mf.set_ranked_garside_normal_form(&ArtinA_rgnf,MAX_PERMUTATION_SIZE-1);
+  ArtinA_mf.set_ranked_garside_power(&ArtinA_rgp);
+  ArtinA_mf.set_indexed_generator(&ArtinA_igen);
+  ArtinA_mf.set_ranked_lattice_factory(&ArtinA_rlf,ARTIN_A_LATTICE_RANK);
+  ArtinA_mf.set_ranked_conjugacy_factory(&ArtinA_rcf,MAX_PERMUTATION_SIZE-1);
   
   DualA_mf.data=(void*)type_DualWordA;
-  DualA_mf.set_left_complement(&DualA_left_sc);
-  DualA_mf.set_right_complement(&DualA_right_sc);
+  DualA_mf.set_left_reversing(new ReversingEngine<LeftDirection,TabulatedComplement<DualA_left_sc>>(&DualA_left_sc));
+  DualA_mf.set_right_reversing(new ReversingEngine<RightDirection,TabulatedComplement<DualA_right_sc>>(&DualA_right_sc));
   DualA_mf.set_ranked_phi_germ(&DualA_rpg);
   DualA_mf.set_ranked_garside_word_factory(&DualA_rgwf);
-}
-
-//------------------------------------------------
-// ArtinA_left_sc(Generator,Generator,Generator*)
-//------------------------------------------------
-
-int ArtinA_left_sc(const Generator& x,const Generator& y,Generator* comp){
-  //Comp statisfy comp*x=...*y
-  if(x==y) return 0;
-  if(abs(x-y)==1){
-    comp[0]=x;
-    comp[1]=y;
-    return 2;
-  }
-  else{
-    comp[0]=y;
-    return 1;
-  }
-}
-
-//-------------------------------------------------
-// ArtinA_rigth_sc(Generator,Generator,Generator*)
-//-------------------------------------------------
-
-int ArtinA_right_sc(const Generator& x,const Generator& y,Generator* comp){
-  //Comp satisfy x*comp=y*...
-  if(x==y) return 0;
-  if(abs(x-y)==1){
-    comp[0]=y;
-    comp[1]=x;
-    return 2;
-  }
-  else{
-    comp[0]=y;
-    return 1;
-  }
+  DualA_mf.set_ranked_garside_normal_form(&DualA_rgnf,MAX_NC_PARTITION_SIZE-1);
+  DualA_mf.set_ranked_garside_power(&DualA_rgp);
+  DualA_mf.set_indexed_generator(&DualA_igen);
+  DualA_mf.set_ranked_lattice_factory(&DualA_rlf,DUAL_A_LATTICE_RANK);
+  DualA_mf.set_ranked_conjugacy_factory(&DualA_rcf,MAX_NC_PARTITION_SIZE-1);
+  DualA_mf.tabulate_complements(BRAIDS_TABULATED_RANK);
 }
 
 //----------------------------------
@@ -111,6 +90,117 @@ Word ArtinA_rgwf(size_t r){
   return res;
 }
 
+//---------------------------------
+// ArtinA_rgnf(size_t,const Word&)
+//---------------------------------
+
+Word ArtinA_rgnf(size_t r,const Word& w){
+  NormalForm<Permutation> nf(r+1);
+  nf.set_word(w);
+  return nf.word();
+}
+
+//----------------------------------------
+// ArtinA_rgp(size_t,const Word&,int64_t)
+//----------------------------------------
+
+Word ArtinA_rgp(size_t r,const Word& w,int64_t k){
+  NormalForm<Permutation> nf(r+1);
+  nf.set_word(w);
+  return nf.power_word(k);
+}
+
+//------------------------------------------------------
+// ArtinA_reversing_equivalent(const Word&,const Word&)
+//------------------------------------------------------
+
+bool ArtinA_reversing_equivalent(const Word& u,const Word& v){
+  return ArtinA_mf.are_equivalent(u,v);
+}
+
+//-----------------------------------
+// ArtinA_handle_reduce(const Word&)
+//-----------------------------------
+
+Word ArtinA_handle_reduce(const Word& w){
+  HandleReduction& hr=thread_handle_reduction;
+  hr.set_word(w);
+  hr.full_reduce();
+  return hr.get_word();
+}
+
+//-----------------------------------------
+// ArtinA_compare(const Word&,const Word&)
+//-----------------------------------------
+
+int ArtinA_compare(const Word& u,const Word& v){
+  HandleReduction& hr=thread_handle_reduction;
+  hr.set_word(u.inverse()*v);
+  hr.full_reduce();
+  return -hr.sign();
+}
+
+//---------------------------
+// ArtinA_braid(const Word&)
+//---------------------------
+
+BraidA ArtinA_braid(const Word& w){
+  BraidA res(ArtinA_mf.rank(w)+1);
+  res.set_word(w);
+  return res;
+}
+
+//---------------------------------------------------
+// ArtinA_braid_compare(const BraidA&,const BraidA&)
+//---------------------------------------------------
+
+int ArtinA_braid_compare(const BraidA& a,const BraidA& b){
+  if(a.n<b.n){
+    BraidA c=a;
+    c.set_size(b.n);
+    return ArtinA_braid_compare(c,b);
+  }
+  if(b.n<a.n) return -ArtinA_braid_compare(b,a);
+  if(a<b) return -1;
+  if(b<a) return 1;
+  return 0;
+}
+
+//---------------------------------------------------
+// ArtinA_braid_product(const BraidA&,const BraidA&)
+//---------------------------------------------------
+
+BraidA ArtinA_braid_product(const BraidA& a,const BraidA& b){
+  if(a.n<b.n){
+    BraidA c=a;
+    c.set_size(b.n);
+    return c*b;
+  }
+  if(b.n<a.n){
+    BraidA c=b;
+    c.set_size(a.n);
+    return a*c;
+  }
+  return a*b;
+}
+
+//--------------------
+// ArtinA_rlf(size_t)
+//--------------------
+
+SimpleLattice* ArtinA_rlf(size_t r){
+  return tabulate_simples<Permutation>(r+1,ArtinA_gnum(r+1),&ArtinA_igen);
+}
+
+//--------------------
+// ArtinA_rcf(size_t)
+//--------------------
+
+ConjugacyEngine* ArtinA_rcf(size_t r){
+  NormalFormSimples<Permutation> simples(r+1,ArtinA_gnum(r+1),&ArtinA_igen);
+  return new GarsideConjugacy<NormalFormSimples<Permutation>>(simples);
+}
+
 //--------------------
 // DualA_gnum(size_t)
 //--------------------
@@ -124,6 +214,20 @@ DualA_gnum(size_t n){
   return res;
 }
 
+//-------------------
+// DualA_igen(size_t)
+//-------------------
+
+Generator DualA_igen(size_t i){
+  //Generators a_pq are ordered by q and then by p
+  uint8_t q=2;
+  while(i>=(size_t)(q-1)){
+    i-=q-1;
+    ++q;
+  }
+  return generator(i+1,q);
+}
+
 //-----------------------------------------------
 // DualA_left_sc(Generator,Generator,Generator*)
 //-----------------------------------------------
@@ -243,6 +347,43 @@ Generator DualA_rpg(size_t r,const Generator& x,int p){
   return sign*generator(i,j);
 }
 
+//--------------------------------
+// DualA_rgnf(size_t,const Word&)
+//--------------------------------
+
+Word DualA_rgnf(size_t r,const Word& w){
+  NormalForm<NCPartition> nf(r+1);
+  nf.set_word(w);
+  return nf.word();
+}
+
+//---------------------------------------
+// DualA_rgp(size_t,const Word&,int64_t)
+//---------------------------------------
+
+Word DualA_rgp(size_t r,const Word& w,int64_t k){
+  NormalForm<NCPartition> nf(r+1);
+  nf.set_word(w);
+  return nf.power_word(k);
+}
+
+//-------------------
+// DualA_rlf(size_t)
+//-------------------
+
+SimpleLattice* DualA_rlf(size_t r){
+  return tabulate_simples<NCPartition>(r+1,DualA_gnum(r+1),&DualA_igen);
+}
+
+//-------------------
+// DualA_rcf(size_t)
+//-------------------
+
+ConjugacyEngine* DualA_rcf(size_t r){
+  NormalFormSimples<NCPartition> simples(r+1,DualA_gnum(r+1),&DualA_igen);
+  return new GarsideConjugacy<NormalFormSimples<NCPartition>>(simples);
+}
+
 //--------------------
 // DualA_rgwf(size_t)
 //--------------------
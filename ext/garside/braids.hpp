@@ -20,6 +20,29 @@
 #ifndef BRAIDS_HPP
 #define BRAIDS_HPP
 #include "monoid.hpp"
+#include "permutation.hpp"
+#include "nc_partition.hpp"
+#include "normal_form.hpp"
+#include "burau.hpp"
+#include "dynnikov.hpp"
+#include "handle_reduction.hpp"
+#include "lawrence_krammer.hpp"
+
+//! Rank up to which complements are tabulated at initialisation
+#define BRAIDS_TABULATED_RANK 15
+
+//! Ranks up to which lattices of simple elements are built, i.e.,
+//! 6! Artin and Catalan(7) dual simple elements
+#define ARTIN_A_LATTICE_RANK 5
+#define DUAL_A_LATTICE_RANK 6
+
+//*********************
+//* Type declarations *
+//*********************
+
+//! Braid of type A given by its left normal form Delta^k.s1...sm, simple
+//! factors being stored as permutations
+typedef NormalForm<Permutation> BraidA;
 
 //******************
 //* Global objects *
@@ -28,6 +51,13 @@
 extern MonoidFamily ArtinA_mf;
 extern MonoidFamily DualA_mf;
 
+//! Word problem solver of ArtinA used to test equivalence of signed words
+extern WordProblem ArtinA_word_problem;
+
+//! Words with different Burau fingerprints are rejected before calling
+//! ArtinA_word_problem
+extern atomic<bool> ArtinA_fingerprint_filter;
+
 //***********************************
 //* Auxiliary functions declaration *
 //***********************************
@@ -48,6 +78,9 @@ string ArtinA_disp(const Generator& x);
 //! Return the number of generators of type A braid of rank n
 size_t ArtinA_gnum(size_t n);
 
+//! Return the i-th generator of type A braids
+Generator ArtinA_igen(size_t i);
+
 //! Set left complement for Artin monoid of type A
 int ArtinA_left_sc(const Generator& x,const Generator &y,Generator* comp);
 
@@ -66,6 +99,52 @@ Generator ArtinA_rpg(size_t r,const Generator& x,int p);
 //! Ranked Garside word factory
 Word ArtinA_rgwf(size_t r);
 
+//! Ranked left-weighted Garside normal form, computed on permutations
+Word ArtinA_rgnf(size_t r,const Word& w);
+
+//! Ranked power, computed by repeated squaring of normal forms on permutations
+Word ArtinA_rgp(size_t r,const Word& w,int64_t k);
+
+//! Ranked lattice of simple elements factory
+SimpleLattice* ArtinA_rlf(size_t r);
+
+//! Ranked conjugacy engine factory, working on permutations
+ConjugacyEngine* ArtinA_rcf(size_t r);
+
+//! Word problem solver using Dynnikov coordinates
+bool ArtinA_dynnikov_equivalent(const Word& u,const Word& v);
+
+//! Word problem solver using the Lawrence-Krammer representation
+bool ArtinA_lawrence_krammer_equivalent(const Word& u,const Word& v);
+
+//! Word problem solver using left reversing
+bool ArtinA_reversing_equivalent(const Word& u,const Word& v);
+
+//! Return the Burau fingerprint of w, cached on w
+uint64_t ArtinA_fingerprint(const Word& w);
+
+//! Test if u and v are equivalent, rejecting words with different Burau
+//! fingerprints before calling ArtinA_word_problem if the filter is on
+bool ArtinA_filtered_equivalent(const Word& u,const Word& v);
+
+//! Return the word obtained from w by full handle reduction
+Word ArtinA_handle_reduce(const Word& w);
+
+//! Compare u and v for the Dehornoy ordering : return -1 if u<v, 0 if u and
+//! v are equivalent and 1 if u>v. We have u<v iff u^-1.v is sigma-positive.
+int ArtinA_compare(const Word& u,const Word& v);
+
+//! Return the braid represented by w on rank(w)+1 strands
+BraidA ArtinA_braid(const Word& w);
+
+//! Compare a and b, the one with less strands being seen on the strands of
+//! the other : return -1 if a<b, 0 if a=b and 1 if a>b
+int ArtinA_braid_compare(const BraidA& a,const BraidA& b);
+
+//! Return the product of a and b, the one with less strands being seen on
+//! the strands of the other
+BraidA ArtinA_braid_product(const BraidA& a,const BraidA& b);
+
 //-----------------
 // Dual of type A
 //-----------------
@@ -76,6 +155,9 @@ string DualA_disp(const Generator& x);
 //! Return the number of generators of type A dual braids of rank n
 size_t DualA_gnum(size_t n);
 
+//! Return the i-th generator of type A dual braids
+Generator DualA_igen(size_t i);
+
 //! Set left complement for dual monoid of type A
 int DualA_left_sc(const Generator& x,const Generator &y,Generator* comp);
 
@@ -94,6 +176,18 @@ Generator DualA_rpg(size_t r,const Generator& x,int p);
 //! Ranked Garside word factory
 Word DualA_rgwf(size_t r);
 
+//! Ranked left-weighted Garside normal form, computed on non-crossing partitions
+Word DualA_rgnf(size_t r,const Word& w);
+
+//! Ranked power, computed by repeated squaring of normal forms on non-crossing partitions
+Word DualA_rgp(size_t r,const Word& w,int64_t k);
+
+//! Ranked lattice of simple elements factory
+SimpleLattice* DualA_rlf(size_t r);
+
+//! Ranked conjugacy engine factory, working on non-crossing partitions
+ConjugacyEngine* DualA_rcf(size_t r);
+
 //**********************
 //* Inline definitions *
 //**********************
@@ -114,11 +208,71 @@ ArtinA_gnum(size_t n){
   return n-1;
 }
 
+inline Generator
+ArtinA_igen(size_t i){
+  return i+1;
+}
+
+inline bool
+ArtinA_dynnikov_equivalent(const Word& u,const Word& v){
+  return DynnikovCoordinates::are_equivalent(u,v);
+}
+
+inline bool
+ArtinA_lawrence_krammer_equivalent(const Word& u,const Word& v){
+  return LawrenceKrammer::are_equivalent(u,v);
+}
+
+inline uint64_t
+ArtinA_fingerprint(const Word& w){
+  if(w.fingerprint==0) w.fingerprint=burau_fingerprint.compute(w);
+  return w.fingerprint;
+}
+
+inline bool
+ArtinA_filtered_equivalent(const Word& u,const Word& v){
+  if(not ArtinA_fingerprint_filter.load(memory_order_relaxed)) return ArtinA_word_problem(u,v);
+  uint64_t fu=ArtinA_fingerprint(u);
+  uint64_t fv=ArtinA_fingerprint(v);
+  if(fu!=BURAU_NONE and fv!=BURAU_NONE and fu!=fv) return false;
+  return ArtinA_word_problem(u,v);
+}
+
+inline int
+ArtinA_left_sc(const Generator& x,const Generator& y,Generator* comp){
+  //Comp statisfy comp*x=...*y
+  if(x==y) return 0;
+  if(abs(x-y)==1){
+    comp[0]=x;
+    comp[1]=y;
+    return 2;
+  }
+  else{
+    comp[0]=y;
+    return 1;
+  }
+}
+
 inline size_t
 ArtinA_rank(const Generator& x){
   return abs(x);
 }
 
+inline int
+ArtinA_right_sc(const Generator& x,const Generator& y,Generator* comp){
+  //Comp satisfy x*comp=y*...
+  if(x==y) return 0;
+  if(abs(x-y)==1){
+    comp[0]=y;
+    comp[1]=x;
+    return 2;
+  }
+  else{
+    comp[0]=y;
+    return 1;
+  }
+}
+
 inline string
 DualA_disp(const Generator& x){
   if(x==0) return "e";
@@ -0,0 +1,112 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include "burau.hpp"
+
+//******************
+//* Global objects *
+//******************
+
+BurauFingerprint burau_fingerprint;
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Mix the bits of x (splitmix64 finaliser)
+static inline uint64_t
+mix(uint64_t x){
+  x=(x^(x>>30))*0xbf58476d1ce4e5b9ULL;
+  x=(x^(x>>27))*0x94d049bb133111ebULL;
+  return x^(x>>31);
+}
+
+//********************
+//* BurauFingerprint *
+//********************
+
+//--------------------------------------
+// BurauFingerprint::BurauFingerprint()
+//--------------------------------------
+
+BurauFingerprint::BurauFingerprint(){
+  nmod_init(&mod,BURAU_PRIME);
+  random_device rd;
+  uint64_t r=(uint64_t(rd())<<32)|rd();
+  seed=(uint64_t(rd())<<32)|rd();
+  //t is neither 0 nor 1 so that generators act non trivially
+  t=2+r%(BURAU_PRIME-2);
+  t_inv=n_invmod(t,BURAU_PRIME);
+  one_minus_t=nmod_sub(1,t,mod);
+  one_minus_t_inv=nmod_sub(1,t_inv,mod);
+}
+
+//----------------------------------------
+// BurauFingerprint::compute(const Word&)
+//----------------------------------------
+
+uint64_t
+BurauFingerprint::compute(const Word& w) const{
+  size_t n=1;
+  for(size_t i=0;i<w.size();++i) n=max(n,(size_t)abs(w.read(i))+1);
+  if(n>BURAU_MAX_STRANDS) return BURAU_NONE;
+  //Matrix stored by columns, starting from identity
+  vector<mp_limb_t> m(n*n,0);
+  for(size_t i=0;i<n;++i) m[i*n+i]=1;
+  for(size_t k=0;k<w.size();++k){
+    Generator x=w.read(k);
+    mp_limb_t* a=&m[(abs(x)-1)*n];
+    mp_limb_t* b=a+n;
+    if(x>0){
+      //Right multiplication by ((1-t,t),(1,0)) on columns a and b
+      for(size_t i=0;i<n;++i){
+        mp_limb_t u=a[i];
+        a[i]=nmod_add(nmod_mul(one_minus_t,u,mod),b[i],mod);
+        b[i]=nmod_mul(t,u,mod);
+      }
+    }
+    else{
+      //Right multiplication by ((0,1),(t^-1,1-t^-1)) on columns a and b
+      for(size_t i=0;i<n;++i){
+        mp_limb_t u=a[i];
+        a[i]=nmod_mul(t_inv,b[i],mod);
+        b[i]=nmod_add(u,nmod_mul(one_minus_t_inv,b[i],mod),mod);
+      }
+    }
+  }
+  mp_limb_t res=0;
+  for(size_t j=0;j<n;++j){
+    m[j*n+j]=nmod_sub(m[j*n+j],1,mod);
+    for(size_t i=0;i<n;++i){
+      mp_limb_t c=m[j*n+i];
+      if(c!=0) res=nmod_add(res,nmod_mul(c,weight(i,j),mod),mod);
+    }
+  }
+  return res+1;
+}
+
+//-----------------------------------------
+// BurauFingerprint::weight(size_t,size_t)
+//-----------------------------------------
+
+mp_limb_t
+BurauFingerprint::weight(size_t i,size_t j) const{
+  return mix(seed^((uint64_t(i)<<32)|j))%BURAU_PRIME;
+}
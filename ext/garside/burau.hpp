@@ -0,0 +1,80 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BURAU_HPP
+#define BURAU_HPP
+
+#include <cstdint>
+#include "flint/nmod_vec.h"
+#include "flint/ulong_extras.h"
+#include "monoid.hpp"
+
+//! Modulus of Burau fingerprints, the largest prime less than 2^63
+#define BURAU_PRIME 9223372036854775783ULL
+
+//! Maximal number of strands of a fingerprinted word
+#define BURAU_MAX_STRANDS 128
+
+//! Fingerprint of words having too many strands
+#define BURAU_NONE UINT64_MAX
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Fingerprints of braid words of type A. The fingerprint of a word w on n
+//! strands is a weighted sum of the entries of B(w)-Id modulo BURAU_PRIME,
+//! where B(w) is the unreduced Burau matrix of w evaluated at a random point.
+//! Weights only depend on positions, so the fingerprint does not depend on n
+//! and equivalent words have the same fingerprint. Letters act on two
+//! columns, hence a word of length l is fingerprinted in O(n^2+n.l).
+class BurauFingerprint{
+public:
+  //! Modulus
+  nmod_t mod;
+  //! Evaluation point t of Burau matrices
+  mp_limb_t t;
+  //! Inverse of t
+  mp_limb_t t_inv;
+  //! Value of 1-t
+  mp_limb_t one_minus_t;
+  //! Value of 1-t^-1
+  mp_limb_t one_minus_t_inv;
+  //! Seed of the weights of matrix entries
+  uint64_t seed;
+
+  //! Construct a fingerprint engine with random point and weights
+  BurauFingerprint();
+
+  //! Return the fingerprint of w, that is an integer in [1,BURAU_PRIME],
+  //! or BURAU_NONE if w has more than BURAU_MAX_STRANDS strands
+  uint64_t compute(const Word& w) const;
+
+  //! Return the weight of the entry (i,j)
+  mp_limb_t weight(size_t i,size_t j) const;
+};
+
+//******************
+//* Global objects *
+//******************
+
+//! Fingerprint engine shared by all threads
+extern BurauFingerprint burau_fingerprint;
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "conjugacy.hpp"
+
+//******************
+//* LatticeSimples *
+//******************
+
+//------------------------------------------------------
+// LatticeSimples::LatticeSimples(const SimpleLattice*)
+//------------------------------------------------------
+
+LatticeSimples::LatticeSimples(const SimpleLattice* l):lattice(l){
+  for(size_t s=1;s<lattice->size;++s){
+    if(lattice->words[s].size()==1) atoms.push_back(s);
+  }
+}
+
+//--------------------------------------------------------
+// LatticeSimples::element(const Word&,vector<uint16_t>&)
+//--------------------------------------------------------
+
+int
+LatticeSimples::element(const Word& w,vector<uint16_t>& factors) const{
+  deque<uint16_t> f;
+  int delta=lattice->left_normal_form(w,f);
+  factors.assign(f.begin(),f.end());
+  return delta;
+}
+
+//--------------------------------------------
+// LatticeSimples::product(uint16_t,uint16_t)
+//--------------------------------------------
+
+uint16_t
+LatticeSimples::product(uint16_t a,uint16_t b) const{
+  const Word& w=lattice->words[b];
+  for(size_t i=0;i<w.size();++i){
+    a=lattice->product[a*lattice->ngens+lattice->column[w.read(i)]];
+  }
+  return a;
+}
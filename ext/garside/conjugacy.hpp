@@ -0,0 +1,954 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONJUGACY_HPP
+#define CONJUGACY_HPP
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+#include "lattice.hpp"
+#include "nc_partition.hpp"
+#include "normal_form.hpp"
+#include "permutation.hpp"
+#include "thread_pool.hpp"
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Element Delta^delta.s1...sk of a Garside group given by its left-weighted
+//! normal form, simple factors being of type T. No factor is the identity or
+//! the Garside element.
+template<class T> class GarsideElement{
+public:
+  //! Power of the Garside element
+  int delta;
+  //! Simple factors s1...sk
+  vector<T> factors;
+
+  //! Return the canonical length k
+  size_t canonical_length() const;
+
+  //! Return a hash of the normal form
+  size_t hash() const;
+
+  //! Return the infimum
+  int inf() const;
+
+  //! Return the supremum
+  int sup() const;
+
+  //! Equality operator
+  bool operator==(const GarsideElement& x) const;
+};
+
+//! Hash functor of GarsideElement
+class GarsideElementHash{
+public:
+  template<class T> size_t operator()(const GarsideElement<T>& x) const;
+};
+
+//! Conjugacy tools of a Garside group, working on words
+class ConjugacyEngine{
+public:
+  //! Destructor
+  virtual ~ConjugacyEngine(){}
+
+  //! Test if the elements represented by u and v are conjugated
+  virtual bool are_conjugate(const Word& u,const Word& v) const=0;
+
+  //! Return the normal form of the cyclic sliding of w
+  virtual Word cyclic_sliding(const Word& w) const=0;
+
+  //! Return the normal form of the cycling of w
+  virtual Word cycling(const Word& w) const=0;
+
+  //! Return the normal form of the decycling of w
+  virtual Word decycling(const Word& w) const=0;
+
+  //! Return the normal forms of the ultra summit set of w
+  virtual vector<Word> ultra_summit_set(const Word& w) const=0;
+};
+
+//! Simple elements tabulated in a SimpleLattice, given by their indices.
+//! This is the fast path of GarsideConjugacy for small ranks.
+class LatticeSimples{
+public:
+  typedef uint16_t Simple;
+  //! Lattice of simple elements
+  const SimpleLattice* lattice;
+  //! Simple elements of length one
+  vector<uint16_t> atoms;
+
+  //! Construct simple elements of lattice
+  LatticeSimples(const SimpleLattice* lattice);
+
+  //! Return the Garside element
+  uint16_t delta() const;
+
+  //! Return the length of the Garside element
+  size_t delta_length() const;
+
+  //! Set factors to the simple factors of the left normal form of the
+  //! element represented by w and return its power of Delta
+  int element(const Word& w,vector<uint16_t>& factors) const;
+
+  //! Return the identity
+  uint16_t identity() const;
+
+  //! Test if s is the Garside element
+  bool is_delta(uint16_t s) const;
+
+  //! Test if s is the identity
+  bool is_identity(uint16_t s) const;
+
+  //! Return the join of a and b for the left divisibility
+  uint16_t join(uint16_t a,uint16_t b) const;
+
+  //! Make the pair (a,b) left-weighted, return false if it was
+  bool left_weight(uint16_t& a,uint16_t& b) const;
+
+  //! Return the meet of a and b for the left divisibility
+  uint16_t meet(uint16_t a,uint16_t b) const;
+
+  //! Return a.b, which must be simple
+  uint16_t product(uint16_t a,uint16_t b) const;
+
+  //! Return a^-1.b where a left divides b
+  uint16_t quotient(uint16_t a,uint16_t b) const;
+
+  //! Return the right complement s^-1.Delta
+  uint16_t right_complement(uint16_t s) const;
+
+  //! Return Delta^k.s.Delta^-k
+  uint16_t twist(int k,uint16_t s) const;
+
+  //! Return the word of s
+  Word word(uint16_t s) const;
+};
+
+//! Simple elements of class S on n strands or points, see NormalForm, which
+//! must also provide a product, an inverse, a join and a meet. This is the
+//! fallback of GarsideConjugacy for ranks having no SimpleLattice.
+template<class S> class NormalFormSimples{
+public:
+  typedef S Simple;
+  //! Size parameter of simple elements
+  size_t n;
+  //! Simple elements of length one
+  vector<S> atoms;
+
+  //! Construct simple elements on n strands whose atoms are the g first
+  //! generators given by ig
+  NormalFormSimples(size_t n,size_t g,IndexedGenerator ig);
+
+  //! See LatticeSimples
+  S delta() const;
+  size_t delta_length() const;
+  int element(const Word& w,vector<S>& factors) const;
+  S identity() const;
+  bool is_delta(const S& s) const;
+  bool is_identity(const S& s) const;
+  S join(const S& a,const S& b) const;
+  bool left_weight(S& a,S& b) const;
+  S meet(const S& a,const S& b) const;
+  S product(const S& a,const S& b) const;
+  S quotient(const S& a,const S& b) const;
+  S right_complement(const S& s) const;
+  S twist(int k,const S& s) const;
+  Word word(const S& s) const;
+};
+
+//! Conjugacy tools of a Garside group whose simple elements are given by the
+//! policy Simples, that is LatticeSimples or NormalFormSimples : cycling,
+//! decycling, cyclic sliding and super and ultra summit sets. Conjugation
+//! of x by s is s^-1.x.s, tau is the inner automorphism s -> Delta^-1.s.Delta
+//! and a\b is the minimal simple element c such that b left divides a.c.
+//! Ultra summit sets are explored along minimal simple elements computed
+//! with Gebhardt's transports and pullbacks.
+template<class Simples> class GarsideConjugacy:public ConjugacyEngine{
+public:
+  typedef typename Simples::Simple Simple;
+  typedef GarsideElement<Simple> Element;
+  //! Simple elements
+  Simples simples;
+
+  //! Construct an engine working on simple elements s
+  GarsideConjugacy(const Simples& s);
+
+  //! Test if the elements represented by u and v are conjugated
+  bool are_conjugate(const Word& u,const Word& v) const;
+
+  //! Replace x by its conjugate by s
+  void conjugate(Element& x,const Simple& s) const;
+
+  //! Return the normal form of the cyclic sliding of w
+  Word cyclic_sliding(const Word& w) const;
+
+  //! Replace x by its cyclic sliding, i.e., its conjugate by its preferred prefix
+  void cyclic_sliding(Element& x) const;
+
+  //! Return the normal form of the cycling of w
+  Word cycling(const Word& w) const;
+
+  //! Replace x by its cycling, i.e., its conjugate by tau^-delta(s1)
+  void cycling(Element& x) const;
+
+  //! Return the normal form of the decycling of w
+  Word decycling(const Word& w) const;
+
+  //! Replace x by its decycling, i.e., its conjugate by sk^-1
+  void decycling(Element& x) const;
+
+  //! Return the element represented by w
+  Element element(const Word& w) const;
+
+  //! Return the initial factor tau^-delta(s1) of x, which conjugates x to
+  //! its cycling
+  Simple initial_factor(const Element& x) const;
+
+  //! Return the inverse of x
+  Element inverse(const Element& x) const;
+
+  //! Test if x, assumed to be in its super summit set, is in its ultra
+  //! summit set, i.e., if x is periodic under cycling
+  bool is_ultra_summit(const Element& x) const;
+
+  //! Return a\b
+  Simple lcm_complement(const Simple& a,const Simple& b) const;
+
+  //! Replace x by s.x
+  void left_multiply(Element& x,const Simple& s) const;
+
+  //! Return the minimal simple element s such that u left divides s and
+  //! x^s is in the super summit set of x, which must be in it ; xi is the
+  //! inverse of x. This is the convergence of Franco and Gonzalez-Meneses.
+  Simple minimal_super_summit(const Element& x,const Element& xi,Simple u) const;
+
+  //! Return the minimal simple elements s such that x^s is in the ultra
+  //! summit set of x, which must be in it
+  vector<Simple> minimal_ultra_summit(const Element& x) const;
+
+  //! Return the preferred prefix of x, that is tau^-delta(s1)^(sk^-1.Delta)
+  Simple preferred_prefix(const Element& x) const;
+
+  //! Return the pullback of t at x, i.e., the minimal simple element s such
+  //! that x^s is in the super summit set of x and t left divides the
+  //! transport of s ; x must be in its super summit set and xi is its inverse
+  Simple pullback(const Element& x,const Element& xi,const Simple& t) const;
+
+  //! Return the minimal r such that tau^p(u) left divides x'.u.r, where
+  //! x=Delta^p.x', that is the bound of u for conjugators not decreasing
+  //! the infimum of x
+  Simple raise_infimum(const Element& x,const Simple& u) const;
+
+  //! Replace x by x.s
+  void right_multiply(Element& x,const Simple& s) const;
+
+  //! Replace x by a conjugate in its super summit set
+  void super_summit(Element& x) const;
+
+  //! Return the transport iota(x)^-1.s.iota(x^s) of s at x, which
+  //! conjugates the cycling of x to the cycling of x^s
+  Simple transport(const Element& x,const Simple& s) const;
+
+  //! Replace x by a conjugate in its ultra summit set
+  void ultra_summit(Element& x) const;
+
+  //! Return the ultra summit set of x, which must be in it. Conjugates by
+  //! minimal simple elements are explored level by level, the elements of a
+  //! level being handled in parallel. If target is not nullptr the
+  //! exploration stops as soon as target is found.
+  vector<Element> ultra_summit_set(const Element& x,const Element* target=nullptr) const;
+
+  //! Return the normal forms of the ultra summit set of w
+  vector<Word> ultra_summit_set(const Word& w) const;
+
+  //! Return the normal form word of x
+  Word word(const Element& x) const;
+};
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Hash of a simple element given by its index in a lattice
+size_t simple_hash(uint16_t s);
+
+//! Hash of a simple braid
+size_t simple_hash(const Permutation& s);
+
+//! Hash of a simple element of a dual braid monoid
+size_t simple_hash(const NCPartition& s);
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//----------------
+// GarsideElement
+//----------------
+
+template<class T> inline size_t
+GarsideElement<T>::canonical_length() const{
+  return factors.size();
+}
+
+template<class T> size_t
+GarsideElement<T>::hash() const{
+  //FNV-1a on the power of Delta and the factors
+  uint64_t h=14695981039346656037ULL;
+  h=(h^(uint32_t)delta)*1099511628211ULL;
+  for(size_t i=0;i<factors.size();++i){
+    h=(h^simple_hash(factors[i]))*1099511628211ULL;
+  }
+  return h;
+}
+
+template<class T> inline int
+GarsideElement<T>::inf() const{
+  return delta;
+}
+
+template<class T> inline int
+GarsideElement<T>::sup() const{
+  return delta+(int)factors.size();
+}
+
+template<class T> inline bool
+GarsideElement<T>::operator==(const GarsideElement& x) const{
+  return delta==x.delta and factors==x.factors;
+}
+
+//--------------------
+// GarsideElementHash
+//--------------------
+
+template<class T> inline size_t
+GarsideElementHash::operator()(const GarsideElement<T>& x) const{
+  return x.hash();
+}
+
+//----------------
+// LatticeSimples
+//----------------
+
+inline uint16_t
+LatticeSimples::delta() const{
+  return lattice->delta;
+}
+
+inline size_t
+LatticeSimples::delta_length() const{
+  return lattice->words[lattice->delta].size();
+}
+
+inline uint16_t
+LatticeSimples::identity() const{
+  return 0;
+}
+
+inline bool
+LatticeSimples::is_delta(uint16_t s) const{
+  return s==lattice->delta;
+}
+
+inline bool
+LatticeSimples::is_identity(uint16_t s) const{
+  return s==0;
+}
+
+inline uint16_t
+LatticeSimples::join(uint16_t a,uint16_t b) const{
+  return lattice->right_lcm[a*lattice->size+b];
+}
+
+inline bool
+LatticeSimples::left_weight(uint16_t& a,uint16_t& b) const{
+  size_t i=a*lattice->size+b;
+  uint16_t wa=lattice->weighted_left[i];
+  if(wa==a) return false;
+  a=wa;
+  b=lattice->weighted_right[i];
+  return true;
+}
+
+inline uint16_t
+LatticeSimples::meet(uint16_t a,uint16_t b) const{
+  return lattice->left_gcd[a*lattice->size+b];
+}
+
+inline uint16_t
+LatticeSimples::quotient(uint16_t a,uint16_t b) const{
+  return lattice->left_quotient[a*lattice->size+b];
+}
+
+inline uint16_t
+LatticeSimples::right_complement(uint16_t s) const{
+  return lattice->right_complement[s];
+}
+
+inline uint16_t
+LatticeSimples::twist(int k,uint16_t s) const{
+  int p=lattice->period;
+  return lattice->twist[(((k%p)+p)%p)*lattice->size+s];
+}
+
+inline Word
+LatticeSimples::word(uint16_t s) const{
+  return lattice->words[s];
+}
+
+//-------------------
+// NormalFormSimples
+//-------------------
+
+template<class S>
+NormalFormSimples<S>::NormalFormSimples(size_t _n,size_t g,IndexedGenerator ig):n(_n){
+  for(size_t k=0;k<g;++k) atoms.push_back(S::atom(n,ig(k)));
+}
+
+template<class S> inline S
+NormalFormSimples<S>::delta() const{
+  return S::delta(n);
+}
+
+template<class S> inline size_t
+NormalFormSimples<S>::delta_length() const{
+  return S::delta(n).word().size();
+}
+
+template<class S> int
+NormalFormSimples<S>::element(const Word& w,vector<S>& factors) const{
+  NormalForm<S> nf(n);
+  nf.set_word(w);
+  factors.assign(nf.factors.begin(),nf.factors.end());
+  return nf.delta_power;
+}
+
+template<class S> inline S
+NormalFormSimples<S>::identity() const{
+  return S(n);
+}
+
+template<class S> inline bool
+NormalFormSimples<S>::is_delta(const S& s) const{
+  return s.is_delta();
+}
+
+template<class S> inline bool
+NormalFormSimples<S>::is_identity(const S& s) const{
+  return s.is_identity();
+}
+
+template<class S> inline S
+NormalFormSimples<S>::join(const S& a,const S& b) const{
+  return S::join(a,b);
+}
+
+template<class S> inline bool
+NormalFormSimples<S>::left_weight(S& a,S& b) const{
+  return S::left_weight(a,b);
+}
+
+template<class S> inline S
+NormalFormSimples<S>::meet(const S& a,const S& b) const{
+  return S::meet(a,b);
+}
+
+template<class S> inline S
+NormalFormSimples<S>::product(const S& a,const S& b) const{
+  return a*b;
+}
+
+template<class S> inline S
+NormalFormSimples<S>::quotient(const S& a,const S& b) const{
+  return a.inverse()*b;
+}
+
+template<class S> inline S
+NormalFormSimples<S>::right_complement(const S& s) const{
+  return s.right_complement();
+}
+
+template<class S> inline S
+NormalFormSimples<S>::twist(int k,const S& s) const{
+  return s.twist(k);
+}
+
+template<class S> inline Word
+NormalFormSimples<S>::word(const S& s) const{
+  return s.word();
+}
+
+//------------------
+// GarsideConjugacy
+//------------------
+
+template<class Simples> inline
+GarsideConjugacy<Simples>::GarsideConjugacy(const Simples& s):simples(s){
+}
+
+template<class Simples> inline void
+GarsideConjugacy<Simples>::cyclic_sliding(Element& x) const{
+  conjugate(x,preferred_prefix(x));
+}
+
+template<class Simples> inline typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::initial_factor(const Element& x) const{
+  if(x.factors.empty()) return simples.identity();
+  return simples.twist(x.delta,x.factors.front());
+}
+
+template<class Simples> inline typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::lcm_complement(const Simple& a,const Simple& b) const{
+  return simples.quotient(a,simples.join(a,b));
+}
+
+//-------------------
+// Simple hash codes
+//-------------------
+
+inline size_t
+simple_hash(uint16_t s){
+  return s;
+}
+
+inline size_t
+simple_hash(const Permutation& s){
+  size_t h=0;
+  for(size_t k=0;k<s.n;++k) h=h*31+s.image[k];
+  return h;
+}
+
+inline size_t
+simple_hash(const NCPartition& s){
+  return s.packed;
+}
+
+//************************
+//* Template definitions *
+//************************
+
+//----------------------------------------------------------
+// GarsideConjugacy::are_conjugate(const Word&,const Word&)
+//----------------------------------------------------------
+
+template<class Simples> bool
+GarsideConjugacy<Simples>::are_conjugate(const Word& u,const Word& v) const{
+  Element x=element(u);
+  Element y=element(v);
+  ultra_summit(x);
+  ultra_summit(y);
+  if(x.inf()!=y.inf() or x.sup()!=y.sup()) return false;
+  if(x==y) return true;
+  vector<Element> uss=ultra_summit_set(x,&y);
+  return find(uss.begin(),uss.end(),y)!=uss.end();
+}
+
+//-----------------------------------------------------
+// GarsideConjugacy::conjugate(Element&,const Simple&)
+//-----------------------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::conjugate(Element& x,const Simple& s) const{
+  //s^-1=d.Delta^-1 where d=s^-1.Delta, hence s^-1.x.s=d.Delta^-1.x.s
+  right_multiply(x,s);
+  --x.delta;
+  left_multiply(x,simples.right_complement(s));
+}
+
+//-----------------------------------------------
+// GarsideConjugacy::cyclic_sliding(const Word&)
+//-----------------------------------------------
+
+template<class Simples> Word
+GarsideConjugacy<Simples>::cyclic_sliding(const Word& w) const{
+  Element x=element(w);
+  cyclic_sliding(x);
+  return word(x);
+}
+
+//----------------------------------------
+// GarsideConjugacy::cycling(const Word&)
+//----------------------------------------
+
+template<class Simples> Word
+GarsideConjugacy<Simples>::cycling(const Word& w) const{
+  Element x=element(w);
+  cycling(x);
+  return word(x);
+}
+
+//-------------------------------------
+// GarsideConjugacy::cycling(Element&)
+//-------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::cycling(Element& x) const{
+  if(x.factors.empty()) return;
+  Simple s=initial_factor(x);
+  x.factors.erase(x.factors.begin());
+  right_multiply(x,s);
+}
+
+//------------------------------------------
+// GarsideConjugacy::decycling(const Word&)
+//------------------------------------------
+
+template<class Simples> Word
+GarsideConjugacy<Simples>::decycling(const Word& w) const{
+  Element x=element(w);
+  decycling(x);
+  return word(x);
+}
+
+//---------------------------------------
+// GarsideConjugacy::decycling(Element&)
+//---------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::decycling(Element& x) const{
+  if(x.factors.empty()) return;
+  Simple s=x.factors.back();
+  x.factors.pop_back();
+  left_multiply(x,s);
+}
+
+//----------------------------------------
+// GarsideConjugacy::element(const Word&)
+//----------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Element
+GarsideConjugacy<Simples>::element(const Word& w) const{
+  Element x;
+  x.delta=simples.element(w,x.factors);
+  return x;
+}
+
+//-------------------------------------------
+// GarsideConjugacy::inverse(const Element&)
+//-------------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Element
+GarsideConjugacy<Simples>::inverse(const Element& x) const{
+  //As in NormalForm::inverse, the inverse of Delta^p.s1...sm is
+  //Delta^-(p+m).t_m...t_1 with t_i=tau^(p+i)(s_i^-1.Delta)
+  Element res;
+  int m=x.factors.size();
+  res.delta=-(x.delta+m);
+  for(int i=m;i>0;--i){
+    res.factors.push_back(simples.twist(x.delta+i,simples.right_complement(x.factors[i-1])));
+  }
+  return res;
+}
+
+//---------------------------------------------------
+// GarsideConjugacy::is_ultra_summit(const Element&)
+//---------------------------------------------------
+
+template<class Simples> bool
+GarsideConjugacy<Simples>::is_ultra_summit(const Element& x) const{
+  //Cycling is injective on the USS, so the orbit of x comes back to x
+  //if and only if x is in the USS
+  unordered_set<Element,GarsideElementHash> orbit;
+  Element y=x;
+  while(true){
+    cycling(y);
+    if(y==x) return true;
+    if(not orbit.insert(y).second) return false;
+  }
+}
+
+//---------------------------------------------------------
+// GarsideConjugacy::left_multiply(Element&,const Simple&)
+//---------------------------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::left_multiply(Element& x,const Simple& s) const{
+  //s.Delta^p=Delta^p.tau^p(s)
+  Simple t=simples.twist(-x.delta,s);
+  if(simples.is_identity(t)) return;
+  vector<Simple>& f=x.factors;
+  f.insert(f.begin(),t);
+  for(size_t j=0;j+1<f.size();++j){
+    if(not simples.left_weight(f[j],f[j+1])) break;
+  }
+  if(not f.empty() and simples.is_delta(f.front())){
+    f.erase(f.begin());
+    ++x.delta;
+  }
+  while(not f.empty() and simples.is_identity(f.back())) f.pop_back();
+}
+
+//------------------------------------------------------------------------------
+// GarsideConjugacy::minimal_super_summit(const Element&,const Element&,Simple)
+//------------------------------------------------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::minimal_super_summit(const Element& x,const Element& xi,Simple u) const{
+  //Every conjugator s>=u keeping the infimum of x and of its inverse, i.e.,
+  //the supremum of x, is larger than the raised u. Simple elements sending
+  //x in its SSS are closed under meets, so that the fixed point is minimal.
+  while(true){
+    Simple v=raise_infimum(x,u);
+    v=raise_infimum(xi,v);
+    if(v==u) return u;
+    u=v;
+  }
+}
+
+//--------------------------------------------------------
+// GarsideConjugacy::minimal_ultra_summit(const Element&)
+//--------------------------------------------------------
+
+template<class Simples> vector<typename GarsideConjugacy<Simples>::Simple>
+GarsideConjugacy<Simples>::minimal_ultra_summit(const Element& x) const{
+  vector<Simple> res;
+  if(x.factors.empty()) return res;
+  //Cycling orbit x=x_0,...,x_(N-1) of x and inverses of its elements
+  vector<Element> orbit;
+  vector<Element> inverses;
+  Element y=x;
+  do{
+    orbit.push_back(y);
+    inverses.push_back(inverse(y));
+    cycling(y);
+  }while(not(y==x));
+  size_t N=orbit.size();
+  //For an atom a, let F be the transport along the orbit and G the pullback
+  //along it. Then a<=F^k(G^k(a))<=r where r is the minimal simple element
+  //greater than a sending x in its USS, with equality as soon as
+  //F^k(G^k(a)) sends x in its USS.
+  vector<Simple> candidates;
+  for(size_t i=0;i<simples.atoms.size();++i){
+    Simple g=simples.atoms[i];
+    for(size_t k=1;;++k){
+      for(size_t j=N;j>0;--j) g=pullback(orbit[j-1],inverses[j-1],g);
+      Simple s=g;
+      for(size_t l=0;l<k;++l){
+        for(size_t j=0;j<N;++j) s=transport(orbit[j],s);
+      }
+      Element z=x;
+      conjugate(z,s);
+      if(is_ultra_summit(z)){
+        candidates.push_back(s);
+        break;
+      }
+    }
+  }
+  //Only minimal candidates are kept
+  for(size_t i=0;i<candidates.size();++i){
+    const Simple& s=candidates[i];
+    bool minimal=true;
+    for(size_t j=0;j<candidates.size() and minimal;++j){
+      const Simple& t=candidates[j];
+      if(not(t==s) and simples.join(t,s)==s) minimal=false;
+    }
+    if(minimal and find(res.begin(),res.end(),s)==res.end()) res.push_back(s);
+  }
+  return res;
+}
+
+//----------------------------------------------------
+// GarsideConjugacy::preferred_prefix(const Element&)
+//----------------------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::preferred_prefix(const Element& x) const{
+  if(x.factors.empty()) return simples.identity();
+  Simple d=simples.right_complement(x.factors.back());
+  return simples.meet(initial_factor(x),d);
+}
+
+//-------------------------------------------------------------------------
+// GarsideConjugacy::pullback(const Element&,const Element&,const Simple&)
+//-------------------------------------------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::pullback(const Element& x,const Element& xi,const Simple& t) const{
+  //With x=Delta^p.x1...xr, t divides the transport of s iff tau^p(t)
+  //divides x2...xr.s and iota(x).t divides s.Delta, which are lower bounds
+  Simple a=simples.twist(-x.delta,t);
+  for(size_t i=1;i<x.factors.size();++i) a=lcm_complement(x.factors[i],a);
+  Simple d=simples.right_complement(initial_factor(x));
+  Simple b=simples.twist(1,lcm_complement(d,t));
+  return minimal_super_summit(x,xi,simples.join(a,b));
+}
+
+//---------------------------------------------------------------
+// GarsideConjugacy::raise_infimum(const Element&,const Simple&)
+//---------------------------------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::raise_infimum(const Element& x,const Simple& u) const{
+  //The infimum of x^s is at least p iff tau^p(s) divides x'.s, where
+  //tau^p(u)<=tau^p(s) and x'.u<=x'.s if u<=s
+  Simple a=simples.twist(-x.delta,u);
+  for(size_t i=0;i<x.factors.size();++i) a=lcm_complement(x.factors[i],a);
+  a=lcm_complement(u,a);
+  return simples.product(u,a);
+}
+
+//----------------------------------------------------------
+// GarsideConjugacy::right_multiply(Element&,const Simple&)
+//----------------------------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::right_multiply(Element& x,const Simple& s) const{
+  if(simples.is_identity(s)) return;
+  vector<Simple>& f=x.factors;
+  f.push_back(s);
+  for(size_t j=f.size()-1;j>0;--j){
+    if(not simples.left_weight(f[j-1],f[j])) break;
+  }
+  if(not f.empty() and simples.is_delta(f.front())){
+    f.erase(f.begin());
+    ++x.delta;
+  }
+  while(not f.empty() and simples.is_identity(f.back())) f.pop_back();
+}
+
+//------------------------------------------
+// GarsideConjugacy::super_summit(Element&)
+//------------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::super_summit(Element& x) const{
+  //The infimum (resp. supremum) is maximal (resp. minimal) in the
+  //conjugacy class if it is unchanged by |Delta| cyclings (resp. decyclings)
+  size_t m=simples.delta_length();
+  size_t k=0;
+  while(k<m and not x.factors.empty()){
+    int i=x.inf();
+    cycling(x);
+    k=(x.inf()>i)?0:k+1;
+  }
+  k=0;
+  while(k<m and not x.factors.empty()){
+    int s=x.sup();
+    decycling(x);
+    k=(x.sup()<s)?0:k+1;
+  }
+}
+
+//-----------------------------------------------------------
+// GarsideConjugacy::transport(const Element&,const Simple&)
+//-----------------------------------------------------------
+
+template<class Simples> typename GarsideConjugacy<Simples>::Simple
+GarsideConjugacy<Simples>::transport(const Element& x,const Simple& s) const{
+  Element y=x;
+  conjugate(y,s);
+  //The transport is the simple element iota(x)^-1.s.iota(y), and
+  //iota(x)^-1=d.Delta^-1 where d=iota(x)^-1.Delta
+  Element z;
+  z.delta=0;
+  right_multiply(z,s);
+  right_multiply(z,initial_factor(y));
+  --z.delta;
+  left_multiply(z,simples.right_complement(initial_factor(x)));
+  if(z.delta==1) return simples.delta();
+  if(z.factors.empty()) return simples.identity();
+  return z.factors.front();
+}
+
+//------------------------------------------
+// GarsideConjugacy::ultra_summit(Element&)
+//------------------------------------------
+
+template<class Simples> void
+GarsideConjugacy<Simples>::ultra_summit(Element& x) const{
+  super_summit(x);
+  //The first repeated element of the cycling orbit is in the USS
+  unordered_set<Element,GarsideElementHash> orbit;
+  while(orbit.insert(x).second) cycling(x);
+}
+
+//-------------------------------------------------------------------
+// GarsideConjugacy::ultra_summit_set(const Element&,const Element*)
+//-------------------------------------------------------------------
+
+template<class Simples> vector<typename GarsideConjugacy<Simples>::Element>
+GarsideConjugacy<Simples>::ultra_summit_set(const Element& x,const Element* target) const{
+  //The USS is connected by conjugations by minimal simple elements
+  //The conjugates of a level are computed in parallel but merged in index
+  //order, so that the result does not depend on the scheduling.
+  vector<Element> res;
+  unordered_set<Element,GarsideElementHash> visited;
+  visited.insert(x);
+  res.push_back(x);
+  if(target!=nullptr and x==*target) return res;
+  size_t begin=0;
+  while(begin<res.size()){
+    size_t end=res.size();
+    vector<vector<Element>> news(end-begin);
+    parallel_for(end-begin,[&](size_t i){
+      const Element& z=res[begin+i];
+      vector<Simple> minimals=minimal_ultra_summit(z);
+      news[i].assign(minimals.size(),z);
+      for(size_t k=0;k<minimals.size();++k) conjugate(news[i][k],minimals[k]);
+    });
+    for(size_t i=0;i<news.size();++i){
+      for(size_t k=0;k<news[i].size();++k){
+        const Element& y=news[i][k];
+        if(not visited.insert(y).second) continue;
+        res.push_back(y);
+        if(target!=nullptr and y==*target) return res;
+      }
+    }
+    begin=end;
+  }
+  return res;
+}
+
+//-------------------------------------------------
+// GarsideConjugacy::ultra_summit_set(const Word&)
+//-------------------------------------------------
+
+template<class Simples> vector<Word>
+GarsideConjugacy<Simples>::ultra_summit_set(const Word& w) const{
+  Element x=element(w);
+  ultra_summit(x);
+  vector<Element> uss=ultra_summit_set(x);
+  vector<Word> res(uss.size());
+  for(size_t i=0;i<uss.size();++i) res[i]=word(uss[i]);
+  return res;
+}
+
+//----------------------------------------
+// GarsideConjugacy::word(const Element&)
+//----------------------------------------
+
+template<class Simples> Word
+GarsideConjugacy<Simples>::word(const Element& x) const{
+  WordBuilder res;
+  if(x.delta!=0){
+    Word d=simples.word(simples.delta());
+    if(x.delta<0) d=d.inverse();
+    for(int k=abs(x.delta);k>0;--k) res.append(d);
+  }
+  for(size_t i=0;i<x.factors.size();++i){
+    res.append(simples.word(x.factors[i]));
+  }
+  return res.word();
+}
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dynnikov.hpp"
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Return max(x,0)
+static inline int64_t
+positive_part(int64_t x){
+  return x>0?x:0;
+}
+
+//! Return min(x,0)
+static inline int64_t
+negative_part(int64_t x){
+  return x<0?x:0;
+}
+
+//! Set r to max(x,0)
+static inline void
+positive_part(fmpz* r,const fmpz* x){
+  if(fmpz_sgn(x)>0) fmpz_set(r,x);
+  else fmpz_zero(r);
+}
+
+//! Set r to min(x,0)
+static inline void
+negative_part(fmpz* r,const fmpz* x){
+  if(fmpz_sgn(x)<0) fmpz_set(r,x);
+  else fmpz_zero(r);
+}
+
+//***********************
+//* DynnikovCoordinates *
+//***********************
+
+//--------------------------------------------------
+// DynnikovCoordinates::DynnikovCoordinates(size_t)
+//--------------------------------------------------
+
+DynnikovCoordinates::DynnikovCoordinates(size_t _n):n(_n){
+  small=new int64_t[2*n];
+  large=nullptr;
+  for(size_t i=0;i<n;++i){
+    small[2*i]=0;
+    small[2*i+1]=1;
+  }
+}
+
+//---------------------------------------------
+// DynnikovCoordinates::~DynnikovCoordinates()
+//---------------------------------------------
+
+DynnikovCoordinates::~DynnikovCoordinates(){
+  delete[] small;
+  if(large!=nullptr){
+    for(size_t i=0;i<2*n;++i) fmpz_clear(&large[i]);
+    delete[] large;
+  }
+}
+
+//----------------------------------------------
+// DynnikovCoordinates::apply(const Generator&)
+//----------------------------------------------
+
+void
+DynnikovCoordinates::apply(const Generator& x){
+  //The generator x=a(i+1)^(+/-1) acts on (a,b,c,d)=(a(i+1),b(i+1),a(i+2),b(i+2))
+  size_t i=(x>0?x:-x)-1;
+  if(large==nullptr){
+    int64_t* v=&small[2*i];
+    int64_t a=v[0],b=v[1],c=v[2],d=v[3];
+    if(x>0){
+      int64_t e=a-negative_part(b)-c+positive_part(d);
+      v[0]=a+positive_part(b)+positive_part(positive_part(d)-e);
+      v[1]=d-positive_part(e);
+      v[2]=c+negative_part(d)+negative_part(negative_part(b)+e);
+      v[3]=b+positive_part(e);
+    }
+    else{
+      int64_t f=a+negative_part(b)-c-positive_part(d);
+      v[0]=a-positive_part(b)-positive_part(positive_part(d)+f);
+      v[1]=d+negative_part(f);
+      v[2]=c-negative_part(d)-negative_part(negative_part(b)-f);
+      v[3]=b-negative_part(f);
+    }
+    for(size_t k=0;k<4;++k){
+      if(v[k]>DYNNIKOV_SMALL_BOUND or v[k]<-DYNNIKOV_SMALL_BOUND){
+        to_large();
+        return;
+      }
+    }
+    return;
+  }
+  //Same formulas on fmpz integers
+  fmpz* v=&large[2*i];
+  fmpz t[6];
+  for(size_t k=0;k<6;++k) fmpz_init(&t[k]);
+  fmpz* bp=&t[0];
+  fmpz* bm=&t[1];
+  fmpz* dp=&t[2];
+  fmpz* dm=&t[3];
+  fmpz* e=&t[4];
+  fmpz* u=&t[5];
+  positive_part(bp,&v[1]);
+  negative_part(bm,&v[1]);
+  positive_part(dp,&v[3]);
+  negative_part(dm,&v[3]);
+  if(x>0){
+    //e=a-b^- -c+d^+
+    fmpz_sub(e,&v[0],bm);
+    fmpz_sub(e,e,&v[2]);
+    fmpz_add(e,e,dp);
+    //a'=a+b^+ +(d^+ -e)^+
+    fmpz_sub(u,dp,e);
+    positive_part(u,u);
+    fmpz_add(&v[0],&v[0],bp);
+    fmpz_add(&v[0],&v[0],u);
+    //c'=c+d^- +(b^- +e)^-
+    fmpz_add(u,bm,e);
+    negative_part(u,u);
+    fmpz_add(&v[2],&v[2],dm);
+    fmpz_add(&v[2],&v[2],u);
+    //b'=d-e^+ and d'=b+e^+
+    positive_part(u,e);
+    fmpz_sub(dp,&v[3],u);
+    fmpz_add(&v[3],&v[1],u);
+    fmpz_set(&v[1],dp);
+  }
+  else{
+    //f=a+b^- -c-d^+
+    fmpz_add(e,&v[0],bm);
+    fmpz_sub(e,e,&v[2]);
+    fmpz_sub(e,e,dp);
+    //a'=a-b^+ -(d^+ +f)^+
+    fmpz_add(u,dp,e);
+    positive_part(u,u);
+    fmpz_sub(&v[0],&v[0],bp);
+    fmpz_sub(&v[0],&v[0],u);
+    //c'=c-d^- -(b^- -f)^-
+    fmpz_sub(u,bm,e);
+    negative_part(u,u);
+    fmpz_sub(&v[2],&v[2],dm);
+    fmpz_sub(&v[2],&v[2],u);
+    //b'=d+f^- and d'=b-f^-
+    negative_part(u,e);
+    fmpz_add(dp,&v[3],u);
+    fmpz_sub(&v[3],&v[1],u);
+    fmpz_set(&v[1],dp);
+  }
+  for(size_t k=0;k<6;++k) fmpz_clear(&t[k]);
+}
+
+//-----------------------------------------
+// DynnikovCoordinates::apply(const Word&)
+//-----------------------------------------
+
+void
+DynnikovCoordinates::apply(const Word& w){
+  for(size_t i=0;i<w.size();++i) apply(w.read(i));
+}
+
+//--------------------------------------------------------------
+// DynnikovCoordinates::are_equivalent(const Word&,const Word&)
+//--------------------------------------------------------------
+
+bool
+DynnikovCoordinates::are_equivalent(const Word& u,const Word& v){
+  size_t n=1;
+  for(size_t i=0;i<u.size();++i) n=max(n,(size_t)abs(u.read(i))+1);
+  for(size_t i=0;i<v.size();++i) n=max(n,(size_t)abs(v.read(i))+1);
+  DynnikovCoordinates du(n),dv(n);
+  du.apply(u);
+  dv.apply(v);
+  return du==dv;
+}
+
+//---------------------------------
+// DynnikovCoordinates::to_large()
+//---------------------------------
+
+void
+DynnikovCoordinates::to_large(){
+  if(large!=nullptr) return;
+  large=new fmpz[2*n];
+  for(size_t i=0;i<2*n;++i){
+    fmpz_init(&large[i]);
+    fmpz_set_si(&large[i],small[i]);
+  }
+}
+
+//-------------------------------------------------------------------
+// DynnikovCoordinates::operator==(const DynnikovCoordinates&) const
+//-------------------------------------------------------------------
+
+bool
+DynnikovCoordinates::operator==(const DynnikovCoordinates& d) const{
+  if(n!=d.n) return false;
+  if(large==nullptr and d.large==nullptr){
+    return memcmp(small,d.small,2*n*sizeof(int64_t))==0;
+  }
+  //Coordinates may be large and then small again, so kinds are mixed
+  fmpz x,y;
+  fmpz_init(&x);
+  fmpz_init(&y);
+  bool res=true;
+  for(size_t i=0;i<2*n and res;++i){
+    if(large!=nullptr) fmpz_set(&x,&large[i]);
+    else fmpz_set_si(&x,small[i]);
+    if(d.large!=nullptr) fmpz_set(&y,&d.large[i]);
+    else fmpz_set_si(&y,d.small[i]);
+    res=fmpz_equal(&x,&y);
+  }
+  fmpz_clear(&x);
+  fmpz_clear(&y);
+  return res;
+}
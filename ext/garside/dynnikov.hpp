@@ -0,0 +1,93 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DYNNIKOV_HPP
+#define DYNNIKOV_HPP
+
+#include <cstdint>
+#include "flint/fmpz.h"
+#include "monoid.hpp"
+
+//! Bound on absolute values of 64 bits coordinates before an action of a
+//! generator. An action multiplies it by at most 7, so there is no overflow.
+#define DYNNIKOV_SMALL_BOUND (int64_t(1)<<59)
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Dynnikov coordinates (a1,b1,...,an,bn) of the image of the trivial
+//! lamination of the disk with n punctures under a braid of type A. The
+//! action of a generator is piecewise linear on four coordinates, so that two
+//! braid words are equivalent iff they give the same coordinates. Coordinates
+//! are 64 bits integers until they may overflow and fmpz integers after.
+class DynnikovCoordinates{
+public:
+  //! Number of strands
+  size_t n;
+  //! Coordinates on 64 bits, a_i being at 2i-2 and b_i at 2i-1
+  int64_t* small;
+  //! Coordinates on fmpz integers, nullptr if small ones are used
+  fmpz* large;
+
+  //! Construct the coordinates of the trivial lamination on n strands
+  DynnikovCoordinates(size_t n);
+
+  //! No copy constructor
+  DynnikovCoordinates(const DynnikovCoordinates&)=delete;
+
+  //! Destructor
+  ~DynnikovCoordinates();
+
+  //! Apply the generator x, whose absolute value is less than n
+  void apply(const Generator& x);
+
+  //! Apply the letters of w from left to right
+  void apply(const Word& w);
+
+  //! Test if two words of type A are equivalent
+  static bool are_equivalent(const Word& u,const Word& v);
+
+  //! Test if coordinates are stored on fmpz integers
+  bool is_large() const;
+
+  //! Switch to fmpz integers
+  void to_large();
+
+  //! No copy assignement
+  DynnikovCoordinates& operator=(const DynnikovCoordinates&)=delete;
+
+  //! Equality test
+  bool operator==(const DynnikovCoordinates& d) const;
+};
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//---------------------
+// DynnikovCoordinates
+//---------------------
+
+inline bool
+DynnikovCoordinates::is_large() const{
+  return large!=nullptr;
+}
+
+#endif
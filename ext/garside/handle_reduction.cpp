@@ -0,0 +1,107 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "handle_reduction.hpp"
+
+//******************
+//* Global objects *
+//******************
+
+thread_local HandleReduction thread_handle_reduction;
+
+//*******************
+//* HandleReduction *
+//*******************
+
+//--------------------------------
+// HandleReduction::full_reduce()
+//--------------------------------
+
+void
+HandleReduction::full_reduce(){
+  //Words before p contains no handle
+  NInd p=word.nodes[0].next;
+  while(p!=0){
+    NData x=word.nodes[p].data;
+    NData i=(x>0)?x:-x;
+    //The handle ending at p, if any, starts at the last letter of index <= i
+    NInd q=word.nodes[p].previous;
+    while(q!=0 and abs(word.nodes[q].data)>i) q=word.nodes[q].previous;
+    if(q==0 or word.nodes[q].data!=-x){
+      p=word.nodes[p].next;
+      continue;
+    }
+    ++steps;
+    NData e=(x>0)?-1:1;
+    NData j=i+1;
+    NInd r=word.nodes[q].next;
+    while(r!=p){
+      NInd n=word.nodes[r].next;
+      NData y=word.nodes[r].data;
+      if(y==j or y==-j){
+        word.nodes[r].data=(y>0)?i:-i;
+        word.insert_before(r,-e*j);
+        word.insert_after(r,e*j);
+      }
+      r=n;
+    }
+    //Handles may now end right after the letter preceding q
+    NInd s=word.nodes[q].previous;
+    word.erase(q);
+    word.erase(p);
+    p=word.nodes[s].next;
+  }
+}
+
+//-----------------------------
+// HandleReduction::get_word()
+//-----------------------------
+
+Word
+HandleReduction::get_word() const{
+  Word res(word.size);
+  size_t i=0;
+  NInd ind=word.nodes[0].next;
+  while(ind!=0){
+    res[i++]=word.nodes[ind].data;
+    ind=word.nodes[ind].next;
+  }
+  return res;
+}
+
+//-------------------------
+// HandleReduction::sign()
+//-------------------------
+
+int
+HandleReduction::sign() const{
+  NData m=0;
+  int res=0;
+  NInd ind=word.nodes[0].next;
+  while(ind!=0){
+    NData x=word.nodes[ind].data;
+    NData i=(x>0)?x:-x;
+    if(m==0 or i<m){
+      m=i;
+      res=(x>0)?1:-1;
+    }
+    ind=word.nodes[ind].next;
+  }
+  return res;
+}
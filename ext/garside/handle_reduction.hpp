@@ -0,0 +1,86 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HANDLE_REDUCTION_HPP
+#define HANDLE_REDUCTION_HPP
+
+#include "stacked_list.hpp"
+#include "monoid.hpp"
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Dehornoy handle reduction of braid words of type A. A a(i)-handle is a
+//! subword a(i)^e.v.a(i)^-e where v only contains letters a(j) with j>i.
+//! Reducing it deletes its ends and replaces each letter a(i+1)^f of v by
+//! a(i+1)^-e.a(i)^f.a(i+1)^e. A reduced word is empty iff the braid is
+//! trivial, otherwise the letters of smallest index all have the same sign.
+class HandleReduction{
+public:
+  //! Internal word
+  StackedList word;
+  //! Number of handles reduced since the word was set
+  size_t steps;
+
+  //! Empty constructor
+  HandleReduction();
+
+  //! Reduce handles until there is no more, always reducing the handle
+  //! ending first so that reduction terminates
+  void full_reduce();
+
+  //! Return internal word
+  Word get_word() const;
+
+  //! Set internal word
+  void set_word(const Word& w);
+
+  //! Return the sign of the internal word once reduced : 0 if it is empty,
+  //! 1 if letters of smallest index are positive and -1 otherwise
+  int sign() const;
+};
+
+//******************
+//* Global objects *
+//******************
+
+//! Handle reduction engine of the calling thread
+extern thread_local HandleReduction thread_handle_reduction;
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//-----------------
+// HandleReduction
+//-----------------
+
+inline
+HandleReduction::HandleReduction(){
+  steps=0;
+}
+
+inline void
+HandleReduction::set_word(const Word& w){
+  word.init((NData*)w.array,w.size());
+  steps=0;
+}
+
+#endif
@@ -24,6 +24,7 @@
 //******************
 
 Gomu::Type* type_ArtinWordA;
+Gomu::Type* type_BraidA;
 Gomu::Type* type_DualWordA;
 Gomu::Type* type_monoid_family;
 Gomu::Type* type_word;
@@ -69,6 +70,7 @@ extern "C"{
   
   Gomu::Module::Type types[]={
     {"ArtinWordA",ArtinWordA_display,word_delete,word_copy,word_compare,&type_ArtinWordA},
+    {"BraidA",BraidA_display,BraidA_delete,BraidA_copy,BraidA_compare,&type_BraidA},
     {"DualWordA",DualWordA_display,word_delete,word_copy,word_compare,&type_DualWordA},
 
     {"ArtinMonoidFamilyA",mf_display,mf_delete,Gomu::no_copy,Gomu::no_comp,&type_monoid_family},
@@ -81,16 +83,33 @@ extern "C"{
   
   Gomu::Module::Function functions[]={
     {"ArtinWordA","operator*",{"ArtinWordA","ArtinWordA"},(void*)word_concatenate},
+    {"BraidA","operator*",{"BraidA","BraidA"},(void*)BraidA_product},
     {"DualWordA","operator*",{"DualWordA","DualWordA"},(void*)word_concatenate},
+    {"ArtinWordA","operator^",{"ArtinWordA","Integer"},(void*)ArtinWordA_power},
+    {"BraidA","operator^",{"BraidA","Integer"},(void*)BraidA_power},
+    {"DualWordA","operator^",{"DualWordA","Integer"},(void*)DualWordA_power},
     {"Boolean","operator===",{"ArtinWordA","ArtinWordA"},(void*)ArtinWordA_equivalent},
     {"Boolean","operator===",{"DualWordA","DualWordA"},(void*)DualWordA_equivalent},
+    {"Boolean","operator<",{"ArtinWordA","ArtinWordA"},(void*)ArtinWordA_less},
+    {"Boolean","operator>",{"ArtinWordA","ArtinWordA"},(void*)ArtinWordA_greater},
+    {"BraidA","braid",{"ArtinWordA"},(void*)BraidA_from_word},
     {"Word","word",{"Array"},(void*)word_from_array},
     FUNC_SENTINEL
   };
   
   Gomu::Module::Function member_functions[]={
     //ArtinMonoidFamilyA
+    {"Boolean","are_conjugate",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mf_are_conjugate},
+    {"ArtinWordA","cyclic_sliding",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_cyclic_sliding},
+    {"ArtinWordA","cycling",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_cycling},
+    {"ArtinWordA","decycling",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_decycling},
     {"ArtinWordA","garside_element",{"ArtinMonoidFamilyA","Integer"},(void*)mf_garside_element},
+    {"ArtinWordA","garside_normal_form",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_garside_normal_form},
+    {"ArtinWordA","garside_normal_form",{"ArtinMonoidFamilyA","Integer","ArtinWordA"},(void*)mf_garside_normal_form_ranked},
+    {"Integer","fingerprint",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)ArtinA_mf_fingerprint},
+    {"ArtinWordA","handle_reduce",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)ArtinA_mf_handle_reduce},
+    {"Integer","handle_reduction_steps",{"ArtinMonoidFamilyA"},(void*)ArtinA_mf_handle_reduction_steps},
+    {"Array","are_equivalent",{"ArtinMonoidFamilyA","Array","Array"},(void*)mt_are_equivalent_array},
     {"Boolean","is_left_divisible",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_is_left_divisible},
     {"Tuple","is_left_divisible_x",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_is_left_divisible_x},
     {"Boolean","is_right_divisible",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_is_right_divisible},
@@ -98,12 +117,18 @@ extern "C"{
     {"ArtinWordA","left_complement",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_left_complement},
     {"ArtinWordA","left_denominator",{"ArtinMonoidFamilyA"},(void*)mt_left_denominator},
     {"ArtinWordA","left_lcm",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_left_lcm},
+    {"Array","left_lcm",{"ArtinMonoidFamilyA","Array","Array"},(void*)mt_left_lcm_array},
     {"ArtinWordA","left_lcm_complement",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_left_lcm_complement},
     {"ArtinWordA","left_gcd",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_left_gcd},
+    {"Array","left_gcd",{"ArtinMonoidFamilyA","Array","Array"},(void*)mt_left_gcd_array},
     {"Tuple","left_gcd_x",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_left_gcd_x},
     {"ArtinWordA","left_numerator",{"ArtinMonoidFamilyA"},(void*)mt_left_numerator},
+    {"Integer","left_reduced_letters",{"ArtinMonoidFamilyA"},(void*)mt_left_reduced_letters},
     {"ArtinWordA","left_reverse",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mt_left_reverse},
     {"ArtinWordA","left_reverse",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_left_reverse2},
+    {"Array","left_reverse",{"ArtinMonoidFamilyA","Array"},(void*)mt_left_reverse_array},
+    {"ArtinWordA","left_reverse",{"ArtinMonoidFamilyA","ArtinWordA","Integer"},(void*)mt_left_reverse_chunks},
+    {"Integer","left_reversing_steps",{"ArtinMonoidFamilyA"},(void*)mt_left_reversing_steps},
     {"ArtinWordA","phi",{"ArtinMonoidFamilyA","Integer","ArtinWordA"},(void*)mf_phi},
     {"ArtinWordA","phi",{"ArtinMonoidFamilyA","Integer","ArtinWordA","Integer"},(void*)mf_phi_power},
     {"ArtinWordA","phi_normal_form",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_phi_normal},
@@ -111,22 +136,47 @@ extern "C"{
     {"Tuple","phi_tail_x",{"ArtinMonoidFamilyA","Integer","ArtinWordA"},(void*)mf_phi_tail_x},
     {"Array","phi_splitting",{"ArtinMonoidFamilyA","Integer","ArtinWordA"},(void*)mf_phi_splitting},
     {"Integer","rank",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_rank},
+    {"Array","ultra_summit_set",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mf_ultra_summit_set},
     {"ArtinWordA","right_complement",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_right_complement},
     {"ArtinWordA","right_denominator",{"ArtinMonoidFamilyA"},(void*)mt_right_denominator},
     {"ArtinWordA","right_lcm",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_right_lcm},
+    {"Array","right_lcm",{"ArtinMonoidFamilyA","Array","Array"},(void*)mt_right_lcm_array},
     {"ArtinWordA","right_lcm_complement",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_right_lcm_complement},
     {"ArtinWordA","right_gcd",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_right_gcd},
+    {"Array","right_gcd",{"ArtinMonoidFamilyA","Array","Array"},(void*)mt_right_gcd_array},
     {"Tuple","right_gcd_x",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_right_gcd_x},
     {"ArtinWordA","right_numerator",{"ArtinMonoidFamilyA"},(void*)mt_right_numerator},
+    {"Integer","right_reduced_letters",{"ArtinMonoidFamilyA"},(void*)mt_right_reduced_letters},
     {"ArtinWordA","right_reverse",{"ArtinMonoidFamilyA","ArtinWordA"},(void*)mt_right_reverse},
     {"ArtinWordA","right_reverse",{"ArtinMonoidFamilyA","ArtinWordA","ArtinWordA"},(void*)mt_right_reverse2},
+    {"Array","right_reverse",{"ArtinMonoidFamilyA","Array"},(void*)mt_right_reverse_array},
+    {"ArtinWordA","right_reverse",{"ArtinMonoidFamilyA","ArtinWordA","Integer"},(void*)mt_right_reverse_chunks},
+    {"Integer","right_reversing_steps",{"ArtinMonoidFamilyA"},(void*)mt_right_reversing_steps},
+    {"Void","set_fingerprint_filter",{"ArtinMonoidFamilyA","Boolean"},(void*)ArtinA_set_fingerprint_filter},
+    {"Void","set_free_reduction",{"ArtinMonoidFamilyA","Boolean"},(void*)mt_set_free_reduction},
+    {"Void","set_word_problem",{"ArtinMonoidFamilyA","String"},(void*)ArtinA_set_word_problem},
 
     //ArtinWordA
     {"Integer","length",{"ArtinWordA"},(void*)word_length},
     {"ArtinWordA","inverse",{"ArtinWordA"},(void*)word_inverse},
 
+    //BraidA
+    {"Integer","canonical_length",{"BraidA"},(void*)BraidA_canonical_length},
+    {"Integer","infimum",{"BraidA"},(void*)BraidA_infimum},
+    {"BraidA","inverse",{"BraidA"},(void*)BraidA_inverse},
+    {"BraidA","power",{"BraidA","Integer"},(void*)BraidA_power},
+    {"Integer","supremum",{"BraidA"},(void*)BraidA_supremum},
+    {"ArtinWordA","word",{"BraidA"},(void*)BraidA_word},
+
     //DualMonoidFamilyA
+    {"Boolean","are_conjugate",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mf_are_conjugate},
+    {"DualWordA","cyclic_sliding",{"DualMonoidFamilyA","DualWordA"},(void*)mf_cyclic_sliding},
+    {"DualWordA","cycling",{"DualMonoidFamilyA","DualWordA"},(void*)mf_cycling},
+    {"DualWordA","decycling",{"DualMonoidFamilyA","DualWordA"},(void*)mf_decycling},
     {"DualWordA","garside_element",{"DualMonoidFamilyA","Integer"},(void*)mf_garside_element},
+    {"DualWordA","garside_normal_form",{"DualMonoidFamilyA","DualWordA"},(void*)mf_garside_normal_form},
+    {"DualWordA","garside_normal_form",{"DualMonoidFamilyA","Integer","DualWordA"},(void*)mf_garside_normal_form_ranked},
+    {"Array","are_equivalent",{"DualMonoidFamilyA","Array","Array"},(void*)mt_are_equivalent_array},
     {"Boolean","is_left_divisible",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_is_left_divisible},
     {"Tuple","is_left_divisible_x",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_is_left_divisible_x},
     {"Boolean","is_right_divisible",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_is_right_divisible},
@@ -134,12 +184,18 @@ extern "C"{
     {"DualWordA","left_complement",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_left_complement},
     {"DualWordA","left_denominator",{"DualMonoidFamilyA"},(void*)mt_left_denominator},
     {"DualWordA","left_lcm",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_left_lcm},
+    {"Array","left_lcm",{"DualMonoidFamilyA","Array","Array"},(void*)mt_left_lcm_array},
     {"DualWordA","left_lcm_complement",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_left_lcm_complement},
     {"DualWordA","left_gcd",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_left_gcd},
+    {"Array","left_gcd",{"DualMonoidFamilyA","Array","Array"},(void*)mt_left_gcd_array},
     {"Tuple","left_gcd_x",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_left_gcd_x},
     {"DualWordA","left_numerator",{"DualMonoidFamilyA"},(void*)mt_left_numerator},
+    {"Integer","left_reduced_letters",{"DualMonoidFamilyA"},(void*)mt_left_reduced_letters},
     {"DualWordA","left_reverse",{"DualMonoidFamilyA","DualWordA"},(void*)mt_left_reverse},
     {"DualWordA","left_reverse",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_left_reverse2},
+    {"Array","left_reverse",{"DualMonoidFamilyA","Array"},(void*)mt_left_reverse_array},
+    {"DualWordA","left_reverse",{"DualMonoidFamilyA","DualWordA","Integer"},(void*)mt_left_reverse_chunks},
+    {"Integer","left_reversing_steps",{"DualMonoidFamilyA"},(void*)mt_left_reversing_steps},
     {"DualWordA","phi",{"DualMonoidFamilyA","Integer","DualWordA"},(void*)mf_phi},
     {"DualWordA","phi",{"DualMonoidFamilyA","Integer","DualWordA","Integer"},(void*)mf_phi_power},
     {"DualWordA","phi_normal_form",{"DualMonoidFamilyA","DualWordA"},(void*)mf_phi_normal},
@@ -147,15 +203,23 @@ extern "C"{
     {"Tuple","phi_tail_x",{"DualMonoidFamilyA","Integer","DualWordA"},(void*)mf_phi_tail_x},
     {"Array","phi_splitting",{"DualMonoidFamilyA","Integer","DualWordA"},(void*)mf_phi_splitting},
     {"Integer","rank",{"DualMonoidFamilyA","DualWordA"},(void*)mf_rank},
+    {"Array","ultra_summit_set",{"DualMonoidFamilyA","DualWordA"},(void*)mf_ultra_summit_set},
     {"DualWordA","right_complement",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_right_complement},
     {"DualWordA","right_denominator",{"DualMonoidFamilyA"},(void*)mt_right_denominator},
     {"DualWordA","right_lcm",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_right_lcm},
+    {"Array","right_lcm",{"DualMonoidFamilyA","Array","Array"},(void*)mt_right_lcm_array},
     {"DualWordA","right_lcm_complement",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_right_lcm_complement},
     {"DualWordA","right_gcd",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_right_gcd},
+    {"Array","right_gcd",{"DualMonoidFamilyA","Array","Array"},(void*)mt_right_gcd_array},
     {"Tuple","right_gcd_x",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_right_gcd_x},
     {"DualWordA","right_numerator",{"DualMonoidFamilyA"},(void*)mt_right_numerator},
+    {"Integer","right_reduced_letters",{"DualMonoidFamilyA"},(void*)mt_right_reduced_letters},
     {"DualWordA","right_reverse",{"DualMonoidFamilyA","DualWordA"},(void*)mt_right_reverse},
     {"DualWordA","right_reverse",{"DualMonoidFamilyA","DualWordA","DualWordA"},(void*)mt_right_reverse2},
+    {"Array","right_reverse",{"DualMonoidFamilyA","Array"},(void*)mt_right_reverse_array},
+    {"DualWordA","right_reverse",{"DualMonoidFamilyA","DualWordA","Integer"},(void*)mt_right_reverse_chunks},
+    {"Integer","right_reversing_steps",{"DualMonoidFamilyA"},(void*)mt_right_reversing_steps},
+    {"Void","set_free_reduction",{"DualMonoidFamilyA","Boolean"},(void*)mt_set_free_reduction},
     
     //DualWordA
     {"Integer","length",{"DualWordA"},(void*)word_length},
@@ -211,6 +275,62 @@ extern "C"{
 //* Fonctions definitions *
 //*************************
 
+//-----------------------------------------------
+// Boolean are_conjugate(MonoidFamily,Word,Word)
+//-----------------------------------------------
+
+void* mf_are_conjugate(void* m,void* u,void* v){
+  ConjugacyEngine* engine=mf_conjugacy_engine((MonoidFamily*)m,*(Word*)u,*(Word*)v);
+  bool res=engine->are_conjugate(*(Word*)u,*(Word*)v);
+  delete engine;
+  return Gomu::to_boolean(res);
+}
+
+//-----------------------------------------------------------------------------
+// ConjugacyEngine* mf_conjugacy_engine(MonoidFamily*,const Word&,const Word&)
+//-----------------------------------------------------------------------------
+
+ConjugacyEngine* mf_conjugacy_engine(MonoidFamily* monoid,const Word& a,const Word& b){
+  size_t rank=max((size_t)1,max(monoid->rank(a),monoid->rank(b)));
+  ConjugacyEngine* engine=monoid->conjugacy_engine(rank);
+  if(engine==nullptr)
+    RuntimeError("Rank is too large for conjugacy computations");
+  return engine;
+}
+
+//----------------------------------------
+// Word cyclic_sliding(MonoidFamily,Word)
+//----------------------------------------
+
+void* mf_cyclic_sliding(void* m,void* w){
+  ConjugacyEngine* engine=mf_conjugacy_engine((MonoidFamily*)m,*(Word*)w,*(Word*)w);
+  Word* res=new Word(engine->cyclic_sliding(*(Word*)w));
+  delete engine;
+  return res;
+}
+
+//---------------------------------
+// Word cycling(MonoidFamily,Word)
+//---------------------------------
+
+void* mf_cycling(void* m,void* w){
+  ConjugacyEngine* engine=mf_conjugacy_engine((MonoidFamily*)m,*(Word*)w,*(Word*)w);
+  Word* res=new Word(engine->cycling(*(Word*)w));
+  delete engine;
+  return res;
+}
+
+//-----------------------------------
+// Word decycling(MonoidFamily,Word)
+//-----------------------------------
+
+void* mf_decycling(void* m,void* w){
+  ConjugacyEngine* engine=mf_conjugacy_engine((MonoidFamily*)m,*(Word*)w,*(Word*)w);
+  Word* res=new Word(engine->decycling(*(Word*)w));
+  delete engine;
+  return res;
+}
+
 //--------------------------------------------
 // Word garside_element(MonoidFamily,Integer)
 //--------------------------------------------
@@ -222,6 +342,36 @@ void* mf_garside_element(void* m,void* r){
  return (void*)(new Word(monoid->garside_element(Gomu::get_slong(r))));
 }
 
+//---------------------------------------------
+// Word garside_normal_form(MonoidFamily,Word)
+//---------------------------------------------
+
+void* mf_garside_normal_form(void* m,void* w){
+  MonoidFamily* monoid=(MonoidFamily*)m;
+  if(not monoid->has_garside_normal_form())
+    RuntimeError("Monoid has not Garside normal form");
+  size_t rank=monoid->rank(*(Word*)w);
+  if(rank>monoid->garside_normal_form_rank)
+    RuntimeError("Rank is too large for Garside normal form");
+  return new Word(monoid->garside_normal_form(rank,*(Word*)w));
+}
+
+//-----------------------------------------------------
+// Word garside_normal_form(MonoidFamily,Integer,Word)
+//-----------------------------------------------------
+
+void* mf_garside_normal_form_ranked(void* m,void* r,void* w){
+  MonoidFamily* monoid=(MonoidFamily*)m;
+  if(not monoid->has_garside_normal_form())
+    RuntimeError("Monoid has not Garside normal form");
+  size_t rank=Gomu::get_slong(r);
+  if(rank>monoid->garside_normal_form_rank)
+    RuntimeError("Rank is too large for Garside normal form");
+  if(monoid->rank(*(Word*)w)>rank)
+    RuntimeError("Word has a rank greater than the given one");
+  return new Word(monoid->garside_normal_form(rank,*(Word*)w));
+}
+
 //-------------------------------------
 // Word phi(MonoidFamily,Integer,Word)
 //-------------------------------------
@@ -292,6 +442,86 @@ void* mf_phi_splitting(void* m,void* r,void* w){
   return (void*)res;
 }
 
+//-------------------------------------------------
+// Array[Word] ultra_summit_set(MonoidFamily,Word)
+//-------------------------------------------------
+
+void* mf_ultra_summit_set(void* m,void* w){
+  MonoidFamily* monoid=(MonoidFamily*)m;
+  ConjugacyEngine* engine=mf_conjugacy_engine(monoid,*(Word*)w,*(Word*)w);
+  vector<Word> uss=engine->ultra_summit_set(*(Word*)w);
+  delete engine;
+  Array<Word> res(uss.size());
+  for(size_t i=0;i<uss.size();++i) res[i]=uss[i];
+  return words_to_array(monoid,res);
+}
+
+//------------------------
+// String display(BraidA)
+//------------------------
+
+string BraidA_display(void* b){
+  BraidA* x=(BraidA*)b;
+  if(x->delta_power==0 and x->factors.empty()) return "e";
+  string res;
+  if(x->delta_power!=0) res="Delta^"+to_string(x->delta_power);
+  for(auto it=x->factors.begin();it!=x->factors.end();++it){
+    if(not res.empty()) res+=".";
+    res+="("+it->word().display(ArtinA_disp)+")";
+  }
+  return res;
+}
+
+//--------------------------
+// BraidA braid(ArtinWordA)
+//--------------------------
+
+void* BraidA_from_word(void* w){
+  if(ArtinA_mf.rank(*(Word*)w)>=MAX_PERMUTATION_SIZE)
+    RuntimeError("Rank is too large for braids");
+  return (void*)new BraidA(ArtinA_braid(*(Word*)w));
+}
+
+//---------------------------------------------------------
+// Void set_fingerprint_filter(ArtinMonoidFamilyA,Boolean)
+//---------------------------------------------------------
+
+void* ArtinA_set_fingerprint_filter(void*,void* b){
+  ArtinA_fingerprint_filter=*(bool*)b;
+  return nullptr;
+}
+
+//--------------------------------------------------
+// Void set_word_problem(ArtinMonoidFamilyA,String)
+//--------------------------------------------------
+
+void* ArtinA_set_word_problem(void*,void* s){
+  const string& name=*(string*)s;
+  if(name=="reversing") ArtinA_word_problem=ArtinA_reversing_equivalent;
+  else if(name=="dynnikov") ArtinA_word_problem=ArtinA_dynnikov_equivalent;
+  else if(name=="lawrence_krammer") ArtinA_word_problem=ArtinA_lawrence_krammer_equivalent;
+  else RuntimeError("Unknown word problem solver, expected reversing, dynnikov or lawrence_krammer");
+  return nullptr;
+}
+
+//--------------------------------------------------------------------
+// Array[Boolean] are_equivalent(MonoidTrait,Array[Word],Array[Word])
+//--------------------------------------------------------------------
+
+void* mt_are_equivalent_array(void* m,void* u,void* v){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  Array<Word> us=words_from_array(monoid,u);
+  Array<Word> vs=words_from_array(monoid,v);
+  if(us.size()!=vs.size()) RuntimeError("Arrays must have the same size");
+  Array<bool> eq=monoid->are_equivalent(us,vs);
+  Gomu::ArrayValue* res=new Gomu::ArrayValue(eq.size());
+  res->type=Gomu::type_boolean;
+  for(size_t i=0;i<res->size;++i){
+    res->tab[i]=Gomu::to_boolean(eq[i]);
+  }
+  return (void*)res;
+}
+
 //--------------------------------------------------
 // Boolean is_left_divisible(MonoidTrait,Word,Word)
 //--------------------------------------------------
@@ -367,6 +597,19 @@ void* mt_left_gcd(void* m,void* a,void *b){
   MonoidTrait* monoid=(MonoidTrait*)m;
   return new Word(monoid->left_gcd(*(Word*)a,*(Word*)b));
 }
+
+//-----------------------------------------------------------
+// Array[Word] left_gcd(MonoidTrait,Array[Word],Array[Word])
+//-----------------------------------------------------------
+
+void* mt_left_gcd_array(void* m,void* a,void* b){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  Array<Word> as=words_from_array(monoid,a);
+  Array<Word> bs=words_from_array(monoid,b);
+  if(as.size()!=bs.size()) RuntimeError("Arrays must have the same size");
+  Array<Word> res=monoid->left_gcd(as,bs);
+  return words_to_array(monoid,res);
+}
     
 //-----------------------------------------------
 // (Word,Word) left_gcd_x(MonoidTrait,Word,Word)
@@ -391,6 +634,19 @@ void* mt_left_lcm(void* m,void* a,void *b){
   return new Word(monoid->left_lcm(*(Word*)a,*(Word*)b));
 }
 
+//-----------------------------------------------------------
+// Array[Word] left_lcm(MonoidTrait,Array[Word],Array[Word])
+//-----------------------------------------------------------
+
+void* mt_left_lcm_array(void* m,void* a,void* b){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  Array<Word> as=words_from_array(monoid,a);
+  Array<Word> bs=words_from_array(monoid,b);
+  if(as.size()!=bs.size()) RuntimeError("Arrays must have the same size");
+  Array<Word> res=monoid->left_lcm(as,bs);
+  return words_to_array(monoid,res);
+}
+
 //-------------------------------------------------
 // Word left_lcm_complement(MonoidTrait,Word,Word)
 //-------------------------------------------------
@@ -411,6 +667,17 @@ void* mt_left_numerator(void* m){
   return new Word(monoid->left_numerator());
 }
 
+//-------------------------------------------
+// Integer left_reduced_letters(MonoidTrait)
+//-------------------------------------------
+
+void* mt_left_reduced_letters(void* m){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_left_complement())
+    RuntimeError("Monoid is not left complemented");
+  return Gomu::to_integer(monoid->left_reduced_letters());
+}
+
 //-------------------------------------
 // Word left_reverse(MonoidTrait,Word)
 //-------------------------------------
@@ -433,6 +700,43 @@ void* mt_left_reverse2(void* m,void* num,void* den){
   return (void*)new Word(monoid->left_reverse(*(Word*)num,*(Word*)den));
 }
 
+//---------------------------------------------------
+// Array[Word] left_reverse(MonoidTrait,Array[Word])
+//---------------------------------------------------
+
+void* mt_left_reverse_array(void* m,void* ws){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_left_complement())
+    RuntimeError("Monoid is not left complemented");
+  Array<Word> res=monoid->left_reverse(words_from_array(monoid,ws));
+  return words_to_array(monoid,res);
+}
+
+//---------------------------------------------
+// Word left_reverse(MonoidTrait,Word,Integer)
+//---------------------------------------------
+
+void* mt_left_reverse_chunks(void* m,void* w,void* c){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_left_complement())
+    RuntimeError("Monoid is not left complemented");
+  int64 chunks=Gomu::get_slong(c);
+  if(chunks<0)
+    RuntimeError("Number of chunks must be non negative");
+  return (void*)new Word(monoid->left_reverse(*(Word*)w,(size_t)chunks));
+}
+
+//-------------------------------------------
+// Integer left_reversing_steps(MonoidTrait)
+//-------------------------------------------
+
+void* mt_left_reversing_steps(void* m){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_left_complement())
+    RuntimeError("Monoid is not left complemented");
+  return Gomu::to_integer(monoid->left_reversing_steps());
+}
+
 //----------------------------------------------
 // Word right_complement(MonoidTrait,Word,Word)
 //----------------------------------------------
@@ -465,6 +769,19 @@ void* mt_right_gcd(void* m,void* a,void *b){
   return new Word(monoid->right_gcd(*(Word*)a,*(Word*)b));
 }
 
+//------------------------------------------------------------
+// Array[Word] right_gcd(MonoidTrait,Array[Word],Array[Word])
+//------------------------------------------------------------
+
+void* mt_right_gcd_array(void* m,void* a,void* b){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  Array<Word> as=words_from_array(monoid,a);
+  Array<Word> bs=words_from_array(monoid,b);
+  if(as.size()!=bs.size()) RuntimeError("Arrays must have the same size");
+  Array<Word> res=monoid->right_gcd(as,bs);
+  return words_to_array(monoid,res);
+}
+
 //-----------------------------------------------
 // (Word,Word) right_gcd_x(MonoidTrait,Word,Word)
 //-----------------------------------------------
@@ -488,6 +805,19 @@ void* mt_right_lcm(void* m,void* a,void *b){
   return new Word(monoid->right_lcm(*(Word*)a,*(Word*)b));
 }
 
+//------------------------------------------------------------
+// Array[Word] right_lcm(MonoidTrait,Array[Word],Array[Word])
+//------------------------------------------------------------
+
+void* mt_right_lcm_array(void* m,void* a,void* b){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  Array<Word> as=words_from_array(monoid,a);
+  Array<Word> bs=words_from_array(monoid,b);
+  if(as.size()!=bs.size()) RuntimeError("Arrays must have the same size");
+  Array<Word> res=monoid->right_lcm(as,bs);
+  return words_to_array(monoid,res);
+}
+
 //--------------------------------------------------
 // Word right_lcm_complement(MonoidTrait,Word,Word)
 //--------------------------------------------------
@@ -508,6 +838,17 @@ void* mt_right_numerator(void* m){
   return new Word(monoid->right_numerator());
 }
 
+//--------------------------------------------
+// Integer right_reduced_letters(MonoidTrait)
+//--------------------------------------------
+
+void* mt_right_reduced_letters(void* m){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_right_complement())
+    RuntimeError("Monoid is not right complemented");
+  return Gomu::to_integer(monoid->right_reduced_letters());
+}
+
 //--------------------------------------
 // Word right_reverse(MonoidTrait,Word)
 //--------------------------------------
@@ -530,6 +871,52 @@ void* mt_right_reverse2(void* m,void* den,void* num){
   return (void*)new Word(monoid->right_reverse(*(Word*)den,*(Word*)num));
 }
 
+//----------------------------------------------------
+// Array[Word] right_reverse(MonoidTrait,Array[Word])
+//----------------------------------------------------
+
+void* mt_right_reverse_array(void* m,void* ws){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_right_complement())
+    RuntimeError("Monoid is not right complemented");
+  Array<Word> res=monoid->right_reverse(words_from_array(monoid,ws));
+  return words_to_array(monoid,res);
+}
+
+//----------------------------------------------
+// Word right_reverse(MonoidTrait,Word,Integer)
+//----------------------------------------------
+
+void* mt_right_reverse_chunks(void* m,void* w,void* c){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_right_complement())
+    RuntimeError("Monoid is not right complemented");
+  int64 chunks=Gomu::get_slong(c);
+  if(chunks<0)
+    RuntimeError("Number of chunks must be non negative");
+  return (void*)new Word(monoid->right_reverse(*(Word*)w,(size_t)chunks));
+}
+
+//--------------------------------------------
+// Integer right_reversing_steps(MonoidTrait)
+//--------------------------------------------
+
+void* mt_right_reversing_steps(void* m){
+  MonoidTrait* monoid=(MonoidTrait*)m;
+  if(not monoid->has_right_complement())
+    RuntimeError("Monoid is not right complemented");
+  return Gomu::to_integer(monoid->right_reversing_steps());
+}
+
+//----------------------------------------------
+// Void set_free_reduction(MonoidTrait,Boolean)
+//----------------------------------------------
+
+void* mt_set_free_reduction(void* m,void* b){
+  ((MonoidTrait*)m)->free_reduction=*(bool*)b;
+  return nullptr;
+}
+
 //-----------------------
 // Word word(ArrayValue)
 //-----------------------
@@ -545,3 +932,32 @@ void* word_from_array(void* arr){
   }
   return res;		 
 }
+
+//------------------------------------------------------
+// Array[Word] words_from_array(MonoidTrait,ArrayValue)
+//------------------------------------------------------
+
+Array<Word> words_from_array(MonoidTrait* monoid,void* arr){
+  Gomu::ArrayValue* array=(Gomu::ArrayValue*)arr;
+  size_t size=array->size;
+  if(size!=0 and array->type!=(Gomu::Type*)monoid->data)
+    RuntimeError("An array of words of the monoid is needed");
+  Array<Word> res(size);
+  for(size_t i=0;i<size;++i){
+    res[i]=*(Word*)array->tab[i];
+  }
+  return res;
+}
+
+//----------------------------------------------------
+// ArrayValue words_to_array(MonoidTrait,Array[Word])
+//----------------------------------------------------
+
+void* words_to_array(MonoidTrait* monoid,Array<Word>& words){
+  Gomu::ArrayValue* res=new Gomu::ArrayValue(words.size());
+  res->type=(Gomu::Type*)monoid->data;
+  for(size_t i=0;i<res->size;++i){
+    res->tab[i]=(void*)(new Word(words[i]));
+  }
+  return (void*)res;
+}
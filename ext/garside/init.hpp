@@ -21,18 +21,36 @@
 #include "../../module.hpp"
 #include "monoid.hpp"
 #include "braids.hpp"
+#include "conjugacy.hpp"
 
 //*****************
 //* Global object *
 //*****************
 
 extern Gomu::Type* type_ArtinWordA;
+extern Gomu::Type* type_BraidA;
 extern Gomu::Type* type_DualWordA;
 
 //****************
 //* MonoidFamily *
 //****************
 
+//! Test if two elements are conjugated
+void* mf_are_conjugate(void* m,void* u,void* v);
+
+//! Return a new conjugacy engine whose rank is that of the letters of a and
+//! b, throw an error if the rank is too large
+ConjugacyEngine* mf_conjugacy_engine(MonoidFamily* monoid,const Word& a,const Word& b);
+
+//! Return the normal form of the cyclic sliding of an element
+void* mf_cyclic_sliding(void* m,void* w);
+
+//! Return the normal form of the cycling of an element
+void* mf_cycling(void* m,void* w);
+
+//! Return the normal form of the decycling of an element
+void* mf_decycling(void* m,void* w);
+
 //! Display a MonoidFamily
 string mf_display(void* m);
 
@@ -42,6 +60,12 @@ void mf_delete(void* m);
 //! Return garside element of a given rank
 void* mf_garside_element(void* m,void* r);
 
+//! Return the Garside normal form of an element
+void* mf_garside_normal_form(void* m,void* w);
+
+//! Return the Garside normal form of an element of a given rank
+void* mf_garside_normal_form_ranked(void* m,void* r,void* w);
+
 //! Return generators number fror rank n
 void* mf_generators_number(void* m,void* n);
 
@@ -66,10 +90,16 @@ void* mf_phi_splitting(void* m,void* r,void* w);
 //! Return the rank of a Word
 void* mf_rank(void* m,void* w);
 
+//! Return the ultra summit set of an element
+void* mf_ultra_summit_set(void* m,void* w);
+
 //***************
 //* MonoidTrait *
 //***************
 
+//! Test equivalence of words of two arrays, in parallel
+void* mt_are_equivalent_array(void* m,void* u,void* v);
+
 //! Test is a left divides b
 void* mt_is_left_divisible(void* m,void* a,void* b);
 
@@ -91,24 +121,42 @@ void* mt_left_denominator(void* m);
 //! Return left gcd of a and b
 void* mt_left_gcd(void* m,void* a,void* b);
 
+//! Return left gcds of words of two arrays, in parallel
+void* mt_left_gcd_array(void* m,void* a,void* b);
+
 //! Return left gcd with extra informations of a and b
 void* mt_left_gcd_x(void* m,void* a,void *b);
 
 //! Return left lcm of a and b
 void* mt_left_lcm(void* m,void* a,void* b);
 
+//! Return left lcms of words of two arrays, in parallel
+void* mt_left_lcm_array(void* m,void* a,void* b);
+
 //! Return left lcm complement of a and b
 void* mt_left_lcm_complement(void* m,void* a,void* b);
 
 //! Return left numerator
 void* mt_left_numerator(void* m);
 
+//! Return the number of letters freely reduced during the last left reversing
+void* mt_left_reduced_letters(void* m);
+
 //! Left reverse a word
 void* mt_left_reverse(void* m,void* w);
 
 //! Left reverse num*den^-1
 void* mt_left_reverse2(void* m,void* num,void* den);
 
+//! Left reverse words of an array, in parallel
+void* mt_left_reverse_array(void* m,void* ws);
+
+//! Left reverse a word split into a given number of chunks, in parallel
+void* mt_left_reverse_chunks(void* m,void* w,void* c);
+
+//! Return the number of steps of the last left reversing
+void* mt_left_reversing_steps(void* m);
+
 //! Return right complememnt
 void* mt_right_complement(void* m,void* a,void*b);
 
@@ -118,24 +166,45 @@ void* mt_right_denominator(void* m);
 //! Return right gcd of a and b
 void* mt_right_gcd(void* m,void* a,void* b);
 
+//! Return right gcds of words of two arrays, in parallel
+void* mt_right_gcd_array(void* m,void* a,void* b);
+
 //! Return right gcd with extra informations of a and b
 void* mt_right_gcd_x(void* m,void* a,void *b);
 
 //! Return right lcm of a and b
 void* mt_right_lcm(void* m,void* a,void* b);
 
+//! Return right lcms of words of two arrays, in parallel
+void* mt_right_lcm_array(void* m,void* a,void* b);
+
 //! Return right lcm complement of a and b
 void* mt_right_lcm_complement(void* m,void* a,void* b);
 
+//! Return the number of letters freely reduced during the last right reversing
+void* mt_right_reduced_letters(void* m);
+
 //! Right reverse a word
 void* mt_right_reverse(void* m,void* w);
 
 //! Right reverse den^-1*num
 void* mt_right_reverse2(void* m,void* den,void* num);
 
+//! Right reverse words of an array, in parallel
+void* mt_right_reverse_array(void* m,void* ws);
+
+//! Right reverse a word split into a given number of chunks, in parallel
+void* mt_right_reverse_chunks(void* m,void* w,void* c);
+
+//! Return the number of steps of the last right reversing
+void* mt_right_reversing_steps(void* m);
+
 //! Return right numerator
 void* mt_right_numerator(void* m);
 
+//! Enable or disable free reduction before reversing
+void* mt_set_free_reduction(void* m,void* b);
+
 
 //********
 //* Word *
@@ -156,6 +225,12 @@ int word_compare(void* w1,void* w2);
 //! Create a Word monoid from an array of integer
 void* word_from_array(void* arr);
 
+//! Return the words of an ArrayValue of words of a monoid
+Array<Word> words_from_array(MonoidTrait* monoid,void* arr);
+
+//! Return an ArrayValue of words of a monoid
+void* words_to_array(MonoidTrait* monoid,Array<Word>& words);
+
 //! Return the length of a Word
 void* word_length(void*);
 
@@ -175,6 +250,72 @@ string ArtinWordA_display(void* w);
 //! Test equivalence between ArtinWordA
 void* ArtinWordA_equivalent(void* u,void* v);
 
+//! Enable or disable the Burau fingerprint filter applied before the word
+//! problem solver of ArtinWordA
+void* ArtinA_set_fingerprint_filter(void*,void* b);
+
+//! Select the word problem solver used to test equivalence between
+//! ArtinWordA, that is "reversing", "dynnikov" or "lawrence_krammer"
+void* ArtinA_set_word_problem(void*,void* s);
+
+//! Test if u<v for the Dehornoy ordering
+void* ArtinWordA_less(void* u,void* v);
+
+//! Test if u>v for the Dehornoy ordering
+void* ArtinWordA_greater(void* u,void* v);
+
+//! Return a power of an ArtinWordA, in normal form
+void* ArtinWordA_power(void* w,void* k);
+
+//! Return the Burau fingerprint of w, -1 if w has too many strands
+void* ArtinA_mf_fingerprint(void*,void* w);
+
+//! Return the word obtained from w by full handle reduction
+void* ArtinA_mf_handle_reduce(void*,void* w);
+
+//! Return the number of handles reduced by the last handle reduction
+void* ArtinA_mf_handle_reduction_steps(void*);
+
+//**********
+//* BraidA *
+//**********
+
+//! Return the canonical length of a BraidA
+void* BraidA_canonical_length(void* b);
+
+//! Compare two BraidA
+int BraidA_compare(void* a,void* b);
+
+//! Copy a BraidA
+void* BraidA_copy(void* b);
+
+//! Delete a BraidA
+void BraidA_delete(void* b);
+
+//! Display a BraidA
+string BraidA_display(void* b);
+
+//! Return the BraidA represented by an ArtinWordA
+void* BraidA_from_word(void* w);
+
+//! Return the infimum of a BraidA
+void* BraidA_infimum(void* b);
+
+//! Return the inverse of a BraidA
+void* BraidA_inverse(void* b);
+
+//! Return a power of a BraidA
+void* BraidA_power(void* b,void* k);
+
+//! Return the product of two BraidA
+void* BraidA_product(void* a,void* b);
+
+//! Return the supremum of a BraidA
+void* BraidA_supremum(void* b);
+
+//! Return the normal form word of a BraidA
+void* BraidA_word(void* b);
+
 //*************
 //* DualWordA *
 //*************
@@ -185,6 +326,9 @@ string DualWordA_display(void* w);
 //! Test equivalence between DualWordA
 void* DualWordA_equivalent(void* u,void* v);
 
+//! Return a power of a DualWordA, in normal form
+void* DualWordA_power(void* w,void* k);
+
 //**********************
 //* Inline definitions *
 //**********************
@@ -268,7 +412,92 @@ ArtinWordA_display(void* w){
 
 inline void*
 ArtinWordA_equivalent(void* u,void* v){
-  return Gomu::to_boolean(ArtinA_mf.are_equivalent(*(Word*)u,*(Word*)v));
+  return Gomu::to_boolean(ArtinA_filtered_equivalent(*(Word*)u,*(Word*)v));
+}
+
+inline void*
+ArtinWordA_less(void* u,void* v){
+  return Gomu::to_boolean(ArtinA_compare(*(Word*)u,*(Word*)v)<0);
+}
+
+inline void*
+ArtinWordA_greater(void* u,void* v){
+  return Gomu::to_boolean(ArtinA_compare(*(Word*)u,*(Word*)v)>0);
+}
+
+inline void*
+ArtinWordA_power(void* w,void* k){
+  return (void*)new Word(ArtinA_mf.power(*(Word*)w,Gomu::get_slong(k)));
+}
+
+inline void*
+ArtinA_mf_fingerprint(void*,void* w){
+  return Gomu::to_integer((int64)ArtinA_fingerprint(*(Word*)w));
+}
+
+inline void*
+ArtinA_mf_handle_reduce(void*,void* w){
+  return (void*)new Word(ArtinA_handle_reduce(*(Word*)w));
+}
+
+inline void*
+ArtinA_mf_handle_reduction_steps(void*){
+  return Gomu::to_integer(thread_handle_reduction.steps);
+}
+
+//--------
+// BraidA
+//--------
+
+inline void*
+BraidA_canonical_length(void* b){
+  return Gomu::to_integer(((BraidA*)b)->factors.size());
+}
+
+inline int
+BraidA_compare(void* a,void* b){
+  return ArtinA_braid_compare(*(BraidA*)a,*(BraidA*)b);
+}
+
+inline void*
+BraidA_copy(void* b){
+  return (void*)new BraidA(*(BraidA*)b);
+}
+
+inline void
+BraidA_delete(void* b){
+  delete (BraidA*)b;
+}
+
+inline void*
+BraidA_infimum(void* b){
+  return Gomu::to_integer(((BraidA*)b)->delta_power);
+}
+
+inline void*
+BraidA_inverse(void* b){
+  return (void*)new BraidA(((BraidA*)b)->inverse());
+}
+
+inline void*
+BraidA_power(void* b,void* k){
+  return (void*)new BraidA(((BraidA*)b)->power(Gomu::get_slong(k)));
+}
+
+inline void*
+BraidA_product(void* a,void* b){
+  return (void*)new BraidA(ArtinA_braid_product(*(BraidA*)a,*(BraidA*)b));
+}
+
+inline void*
+BraidA_supremum(void* b){
+  BraidA* x=(BraidA*)b;
+  return Gomu::to_integer(x->delta_power+(int)x->factors.size());
+}
+
+inline void*
+BraidA_word(void* b){
+  return (void*)new Word(((BraidA*)b)->word());
 }
 
 //------------
@@ -284,3 +513,8 @@ inline void*
 DualWordA_equivalent(void* u,void* v){
   return Gomu::to_boolean(DualA_mf.are_equivalent(*(Word*)u,*(Word*)v));
 }
+
+inline void*
+DualWordA_power(void* w,void* k){
+  return (void*)new Word(DualA_mf.power(*(Word*)w,Gomu::get_slong(k)));
+}
@@ -0,0 +1,152 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lattice.hpp"
+
+//******************
+//* Global objects *
+//******************
+
+const uint16_t SimpleLattice::absent;
+
+//*****************
+//* SimpleLattice *
+//*****************
+
+//--------------------------------
+// SimpleLattice::SimpleLattice()
+//--------------------------------
+
+SimpleLattice::SimpleLattice(){
+  size=0;
+  ngens=0;
+  column=nullptr;
+  product=nullptr;
+  left_gcd=nullptr;
+  right_gcd=nullptr;
+  left_lcm=nullptr;
+  right_lcm=nullptr;
+  left_quotient=nullptr;
+  right_quotient=nullptr;
+  right_complement=nullptr;
+  twist=nullptr;
+  weighted_left=nullptr;
+  weighted_right=nullptr;
+  words=nullptr;
+}
+
+//---------------------------------
+// SimpleLattice::~SimpleLattice()
+//---------------------------------
+
+SimpleLattice::~SimpleLattice(){
+  if(column!=nullptr) delete[] column;
+  if(product!=nullptr) delete[] product;
+  if(left_gcd!=nullptr) delete[] left_gcd;
+  if(right_gcd!=nullptr) delete[] right_gcd;
+  if(left_lcm!=nullptr) delete[] left_lcm;
+  if(right_lcm!=nullptr) delete[] right_lcm;
+  if(left_quotient!=nullptr) delete[] left_quotient;
+  if(right_quotient!=nullptr) delete[] right_quotient;
+  if(right_complement!=nullptr) delete[] right_complement;
+  if(twist!=nullptr) delete[] twist;
+  if(weighted_left!=nullptr) delete[] weighted_left;
+  if(weighted_right!=nullptr) delete[] weighted_right;
+  if(words!=nullptr) delete[] words;
+}
+
+//-----------------------------------
+// SimpleLattice::index(const Word&)
+//-----------------------------------
+
+uint16_t
+SimpleLattice::index(const Word& w) const{
+  uint16_t res=0;
+  for(size_t i=0;i<w.size();++i){
+    Generator x=w[i];
+    if(x<=0 or (size_t)x>max_generator) return absent;
+    uint16_t k=column[x];
+    if(k==absent) return absent;
+    res=product[res*ngens+k];
+    if(res==absent) return absent;
+  }
+  return res;
+}
+
+//---------------------------------------------------------------
+// SimpleLattice::left_normal_form(const Word&,deque<uint16_t>&)
+//---------------------------------------------------------------
+
+int
+SimpleLattice::left_normal_form(const Word& w,deque<uint16_t>& factors) const{
+  //Same algorithm as NormalForm::set_word, on indices of simple elements
+  factors.clear();
+  int delta_power=0;
+  size_t c=0;
+  for(size_t i=0;i<w.size();++i){
+    if(w[i]<0) ++c;
+  }
+  size_t N=c;
+  for(size_t i=0;i<w.size();++i){
+    Generator x=w[i];
+    uint16_t s;
+    if(x>0) s=product[column[x]];
+    else s=right_complement[product[column[-x]]];
+    s=twist[(c%period)*size+s];
+    if(x<0) --c;
+    if(s==0) continue;
+    factors.push_back(s);
+    for(size_t j=factors.size()-1;j>0;--j){
+      uint16_t a=factors[j-1];
+      uint16_t b=factors[j];
+      uint16_t wa=weighted_left[a*size+b];
+      if(wa==a) break;
+      factors[j-1]=wa;
+      factors[j]=weighted_right[a*size+b];
+    }
+    while(not factors.empty() and factors.front()==delta){
+      factors.pop_front();
+      ++delta_power;
+    }
+    while(not factors.empty() and factors.back()==0){
+      factors.pop_back();
+    }
+  }
+  return delta_power-N;
+}
+
+//-----------------------------------------
+// SimpleLattice::normal_form(const Word&)
+//-----------------------------------------
+
+Word
+SimpleLattice::normal_form(const Word& w) const{
+  deque<uint16_t> factors;
+  int delta_power=left_normal_form(w,factors);
+  WordBuilder res;
+  if(delta_power!=0){
+    Word d=words[delta];
+    if(delta_power<0) d=d.inverse();
+    for(int k=abs(delta_power);k>0;--k) res.append(d);
+  }
+  for(auto it=factors.begin();it!=factors.end();++it){
+    res.append(words[*it]);
+  }
+  return res.word();
+}
@@ -0,0 +1,322 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LATTICE_HPP
+#define LATTICE_HPP
+
+#include <deque>
+#include <map>
+#include <vector>
+#include "monoid.hpp"
+
+//! Maximal number of simple elements of a SimpleLattice
+#define MAX_LATTICE_SIZE 1024
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Dense tables of the lattice of simple elements of a Garside monoid
+//! of a given rank. Simple elements are numbered by increasing length,
+//! 0 being the identity; every binary table is indexed by i*size+j.
+class SimpleLattice{
+public:
+  //! Marker of undefined entries
+  static const uint16_t absent=0xFFFF;
+
+  //! Number of simple elements
+  size_t size;
+
+  //! Number of generators
+  size_t ngens;
+
+  //! Index of the Garside element
+  uint16_t delta;
+
+  //! Order of the Garside automorphism on simple elements
+  size_t period;
+
+  //! Column of each generator, indexed by generator values up to max_generator
+  uint16_t* column;
+
+  //! Largest value of a generator
+  size_t max_generator;
+
+  //! Index of s.x for a simple s and a generator x, absent if not simple
+  uint16_t* product;
+
+  //! Left gcd, i.e., meet for the left divisibility
+  uint16_t* left_gcd;
+
+  //! Right gcd, i.e., meet for the right divisibility
+  uint16_t* right_gcd;
+
+  //! Left lcm, i.e., join for the right divisibility
+  uint16_t* left_lcm;
+
+  //! Right lcm, i.e., join for the left divisibility
+  uint16_t* right_lcm;
+
+  //! Index of a^-1.b if a left divides b, absent otherwise
+  uint16_t* left_quotient;
+
+  //! Index of b.a^-1 if a right divides b, absent otherwise
+  uint16_t* right_quotient;
+
+  //! Right complement a^-1.Delta
+  uint16_t* right_complement;
+
+  //! Images under powers of the Garside automorphism, indexed by k*size+i
+  uint16_t* twist;
+
+  //! Left-weighted form (weighted_left,weighted_right) of the pair (a,b)
+  uint16_t* weighted_left;
+  uint16_t* weighted_right;
+
+  //! Word of each simple element
+  Word* words;
+
+  //! Construct an empty lattice
+  SimpleLattice();
+
+  //! A SimpleLattice is not copyable
+  SimpleLattice(const SimpleLattice&)=delete;
+
+  //! Destructor
+  ~SimpleLattice();
+
+  //! Return the index of the simple element represented by the word w,
+  //! or absent if w is not a positive word representing a simple element
+  uint16_t index(const Word& w) const;
+
+  //! Return the left lcm complement of a and b, that is c such that c.a is the left lcm
+  uint16_t left_lcm_complement(uint16_t a,uint16_t b) const;
+
+  //! Set factors to the simple factors s1...sm of the left-weighted normal
+  //! form Delta^k.s1...sm of the element represented by w, whose letters must
+  //! be of rank at most the rank of the lattice, and return k
+  int left_normal_form(const Word& w,deque<uint16_t>& factors) const;
+
+  //! Return the left-weighted normal form Delta^k.s1...sm of the element
+  //! represented by w whose letters must be of rank at most the rank of the lattice
+  Word normal_form(const Word& w) const;
+
+  //! Return the right lcm complement of a and b, that is c such that a.c is the right lcm
+  uint16_t right_lcm_complement(uint16_t a,uint16_t b) const;
+
+  //! A SimpleLattice is not copyable
+  SimpleLattice& operator=(const SimpleLattice&)=delete;
+};
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Build the lattice of simple elements on n strands of class S, see NormalForm,
+//! whose atoms are the g first generators given by ig. The class S must also
+//! provide a product, an inverse and a total order.
+//! \return nullptr if there is more than MAX_LATTICE_SIZE simple elements
+template<class S> SimpleLattice* tabulate_simples(size_t n,size_t g,IndexedGenerator ig);
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//---------------
+// SimpleLattice
+//---------------
+
+inline uint16_t
+SimpleLattice::left_lcm_complement(uint16_t a,uint16_t b) const{
+  return right_quotient[a*size+left_lcm[a*size+b]];
+}
+
+inline uint16_t
+SimpleLattice::right_lcm_complement(uint16_t a,uint16_t b) const{
+  return left_quotient[a*size+right_lcm[a*size+b]];
+}
+
+//************************
+//* Template definitions *
+//************************
+
+//--------------------------------------------------
+// tabulate_simples(size_t,size_t,IndexedGenerator)
+//--------------------------------------------------
+
+template<class S> SimpleLattice*
+tabulate_simples(size_t n,size_t g,IndexedGenerator ig){
+  //Enumerate simple elements by a breadth first search,
+  //so that indices increase with lengths
+  vector<S> simples;
+  map<S,uint16_t> indices;
+  vector<uint16_t> product;
+  simples.push_back(S(n));
+  indices[S(n)]=0;
+  for(size_t i=0;i<simples.size();++i){
+    for(size_t k=0;k<g;++k){
+      S a=simples[i];
+      S x=S::atom(n,ig(k));
+      S::left_weight(a,x);
+      if(not x.is_identity()){
+        product.push_back(SimpleLattice::absent);
+        continue;
+      }
+      auto it=indices.find(a);
+      if(it==indices.end()){
+        if(simples.size()==MAX_LATTICE_SIZE) return nullptr;
+        it=indices.insert(pair<S,uint16_t>(a,simples.size())).first;
+        simples.push_back(a);
+      }
+      product.push_back(it->second);
+    }
+  }
+  size_t N=simples.size();
+  SimpleLattice* lattice=new SimpleLattice;
+  lattice->size=N;
+  lattice->ngens=g;
+  lattice->delta=indices[S::delta(n)];
+  lattice->max_generator=0;
+  for(size_t k=0;k<g;++k){
+    lattice->max_generator=max(lattice->max_generator,(size_t)ig(k));
+  }
+  lattice->column=new uint16_t[lattice->max_generator+1];
+  for(size_t x=0;x<=lattice->max_generator;++x) lattice->column[x]=SimpleLattice::absent;
+  for(size_t k=0;k<g;++k) lattice->column[ig(k)]=k;
+  lattice->product=new uint16_t[N*g];
+  for(size_t i=0;i<N*g;++i) lattice->product[i]=product[i];
+  lattice->words=new Word[N];
+  lattice->right_complement=new uint16_t[N];
+  for(size_t i=0;i<N;++i){
+    lattice->words[i]=simples[i].word();
+    lattice->right_complement[i]=indices[simples[i].right_complement()];
+  }
+  //Powers of the Garside automorphism
+  lattice->period=1;
+  for(size_t k=0;k<g;++k){
+    S x=S::atom(n,ig(k));
+    while(not (x.twist(lattice->period)==x)) ++lattice->period;
+  }
+  lattice->twist=new uint16_t[lattice->period*N];
+  for(size_t p=0;p<lattice->period;++p){
+    for(size_t i=0;i<N;++i){
+      lattice->twist[p*N+i]=indices[simples[i].twist(p)];
+    }
+  }
+  //Sets of left and right divisors as bitsets : every proper left divisor
+  //of s.x is a left divisor of some s and every proper right divisor of
+  //x.s is a right divisor of some s
+  size_t W=(N+63)/64;
+  vector<uint64_t> ldiv(N*W,0),rdiv(N*W,0);
+  for(size_t i=0;i<N;++i){
+    ldiv[i*W+i/64]|=uint64_t(1)<<(i%64);
+    rdiv[i*W+i/64]|=uint64_t(1)<<(i%64);
+  }
+  for(size_t i=0;i<N;++i){
+    for(size_t k=0;k<g;++k){
+      uint16_t t=lattice->product[i*g+k];
+      if(t!=SimpleLattice::absent){
+        for(size_t w=0;w<W;++w) ldiv[t*W+w]|=ldiv[i*W+w];
+      }
+      S x=S::atom(n,ig(k));
+      S b=simples[i];
+      S::left_weight(x,b);
+      if(b.is_identity()){
+        t=indices[x];
+        for(size_t w=0;w<W;++w) rdiv[t*W+w]|=rdiv[i*W+w];
+      }
+    }
+  }
+  //Sets of left and right multiples
+  vector<uint64_t> lmul(N*W,0),rmul(N*W,0);
+  for(size_t i=0;i<N;++i){
+    for(size_t j=0;j<N;++j){
+      if(ldiv[i*W+j/64]>>(j%64)&1) rmul[j*W+i/64]|=uint64_t(1)<<(i%64);
+      if(rdiv[i*W+j/64]>>(j%64)&1) lmul[j*W+i/64]|=uint64_t(1)<<(i%64);
+    }
+  }
+  //Meets are the longest common divisors and joins the shortest common multiples
+  lattice->left_gcd=new uint16_t[N*N];
+  lattice->right_gcd=new uint16_t[N*N];
+  lattice->left_lcm=new uint16_t[N*N];
+  lattice->right_lcm=new uint16_t[N*N];
+  for(size_t i=0;i<N;++i){
+    for(size_t j=0;j<N;++j){
+      size_t lg=0,rg=0,ll=0,rl=0;
+      for(size_t w=W;w>0;--w){
+        uint64_t m=ldiv[i*W+w-1]&ldiv[j*W+w-1];
+        if(m!=0){
+          lg=64*(w-1)+63-__builtin_clzll(m);
+          break;
+        }
+      }
+      for(size_t w=W;w>0;--w){
+        uint64_t m=rdiv[i*W+w-1]&rdiv[j*W+w-1];
+        if(m!=0){
+          rg=64*(w-1)+63-__builtin_clzll(m);
+          break;
+        }
+      }
+      for(size_t w=0;w<W;++w){
+        uint64_t m=lmul[i*W+w]&lmul[j*W+w];
+        if(m!=0){
+          ll=64*w+__builtin_ctzll(m);
+          break;
+        }
+      }
+      for(size_t w=0;w<W;++w){
+        uint64_t m=rmul[i*W+w]&rmul[j*W+w];
+        if(m!=0){
+          rl=64*w+__builtin_ctzll(m);
+          break;
+        }
+      }
+      lattice->left_gcd[i*N+j]=lg;
+      lattice->right_gcd[i*N+j]=rg;
+      lattice->left_lcm[i*N+j]=ll;
+      lattice->right_lcm[i*N+j]=rl;
+    }
+  }
+  //Quotients
+  lattice->left_quotient=new uint16_t[N*N];
+  lattice->right_quotient=new uint16_t[N*N];
+  for(size_t i=0;i<N;++i){
+    S inv=simples[i].inverse();
+    for(size_t j=0;j<N;++j){
+      if(ldiv[j*W+i/64]>>(i%64)&1) lattice->left_quotient[i*N+j]=indices[inv*simples[j]];
+      else lattice->left_quotient[i*N+j]=SimpleLattice::absent;
+      if(rdiv[j*W+i/64]>>(i%64)&1) lattice->right_quotient[i*N+j]=indices[simples[j]*inv];
+      else lattice->right_quotient[i*N+j]=SimpleLattice::absent;
+    }
+  }
+  //Left-weighted form of pairs : (a,b) becomes (a.c,c^-1.b) with c the meet of d(a) and b
+  lattice->weighted_left=new uint16_t[N*N];
+  lattice->weighted_right=new uint16_t[N*N];
+  for(size_t i=0;i<N;++i){
+    uint16_t d=lattice->right_complement[i];
+    for(size_t j=0;j<N;++j){
+      uint16_t c=lattice->left_gcd[d*N+j];
+      lattice->weighted_left[i*N+j]=indices[simples[i]*simples[c]];
+      lattice->weighted_right[i*N+j]=lattice->left_quotient[c*N+j];
+    }
+  }
+  return lattice;
+}
+
+#endif
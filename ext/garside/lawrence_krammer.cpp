@@ -0,0 +1,399 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lawrence_krammer.hpp"
+
+//******************
+//* Global objects *
+//******************
+
+//! Cached representations, built on demand
+static atomic<LawrenceKrammer*> lawrence_krammers[LK_MAX_STRANDS+1];
+
+//! Serialise the building of cached representations
+static mutex lawrence_krammers_mutex;
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Add c.q^a.t^b to p, with q=z and t=z^LK_GENERATOR_SHIFT
+static void
+add_monomial(fmpz_poly_t p,slong c,slong a,slong b){
+  slong e=a+b*LK_GENERATOR_SHIFT;
+  fmpz_poly_set_coeff_si(p,e,fmpz_poly_get_coeff_si(p,e)+c);
+}
+
+//! Set res to p where z^LK_GENERATOR_SHIFT is replaced by z^d
+static void
+spread(fmpz_poly_t res,const fmpz_poly_t p,slong d){
+  fmpz_poly_zero(res);
+  fmpz c,r;
+  fmpz_init(&c);
+  fmpz_init(&r);
+  for(slong e=fmpz_poly_length(p)-1;e>=0;--e){
+    fmpz_poly_get_coeff_fmpz(&c,p,e);
+    if(fmpz_sgn(&c)==0) continue;
+    //Monomials may collide if d is small
+    slong f=e%LK_GENERATOR_SHIFT+(e/LK_GENERATOR_SHIFT)*d;
+    fmpz_poly_get_coeff_fmpz(&r,res,f);
+    fmpz_add(&r,&r,&c);
+    fmpz_poly_set_coeff_fmpz(res,f,&r);
+  }
+  fmpz_clear(&c);
+  fmpz_clear(&r);
+}
+
+//***************
+//* LKGenerator *
+//***************
+
+//-----------------------------
+// LKGenerator::~LKGenerator()
+//-----------------------------
+
+LKGenerator::~LKGenerator(){
+  for(size_t e=0;e<entries.size();++e) fmpz_poly_clear(&entries[e]);
+}
+
+//------------------------------------------------------
+// LKGenerator::append_column(fmpz_poly_struct*,size_t)
+//------------------------------------------------------
+
+void
+LKGenerator::append_column(fmpz_poly_struct* v,size_t N){
+  for(size_t r=0;r<N;++r){
+    if(fmpz_poly_is_zero(&v[r])) continue;
+    rows.push_back(r);
+    //Polynomial data is moved to entries and v[r] is reset
+    entries.push_back(v[r]);
+    fmpz_poly_init(&v[r]);
+  }
+  starts.push_back(rows.size());
+}
+
+//---------------------------------------------------
+// LKGenerator::set_spread(const LKGenerator&,slong)
+//---------------------------------------------------
+
+void
+LKGenerator::set_spread(const LKGenerator& g,slong d){
+  starts=g.starts;
+  rows=g.rows;
+  entries.resize(g.entries.size());
+  for(size_t e=0;e<entries.size();++e){
+    fmpz_poly_init(&entries[e]);
+    spread(&entries[e],&g.entries[e],d);
+  }
+}
+
+//*******************
+//* LawrenceKrammer *
+//*******************
+
+//------------------------------------------
+// LawrenceKrammer::LawrenceKrammer(size_t)
+//------------------------------------------
+
+LawrenceKrammer::LawrenceKrammer(size_t _n):n(_n){
+  N=(n*(n-1))/2;
+  positive=new LKGenerator[n-1];
+  negative=new LKGenerator[n-1];
+  columns=new vector<size_t>[n-1];
+  width=0;
+  for(size_t k=0;k<LK_SPREADS;++k) spreads[k]=nullptr;
+  fmpz_poly_t c0,c1,p;
+  fmpz_poly_init(c0);
+  fmpz_poly_init(c1);
+  fmpz_poly_init(p);
+  //c1=q+tq^2-1 and c0=tq^3-q-tq^2
+  add_monomial(c1,1,1,0);
+  add_monomial(c1,1,2,1);
+  add_monomial(c1,-1,0,0);
+  add_monomial(c0,1,3,1);
+  add_monomial(c0,-1,1,0);
+  add_monomial(c0,-1,2,1);
+  //Dense column used to build sparse ones
+  fmpz_poly_struct* v=new fmpz_poly_struct[N];
+  for(size_t r=0;r<N;++r) fmpz_poly_init(&v[r]);
+  //Position of a column in columns[i-1], N if it is trivial
+  vector<size_t> position(N);
+  for(size_t i=1;i<n;++i){
+    LKGenerator& a=positive[i-1];
+    for(size_t k=2;k<=n;++k){
+      for(size_t j=1;j<k;++j){
+        size_t col=index(j,k);
+        auto add=[&](size_t r,size_t s,slong c,slong qd,slong td){
+          add_monomial(&v[index(r,s)],c,qd,td);
+        };
+        if(i==j and i==k-1){
+          add(j,k,-1,2,1);
+        }
+        else if(i==j-1){
+          add(i,k,1,1,0);
+          add(i,j,1,2,0);
+          add(i,j,-1,1,0);
+          add(j,k,1,0,0);
+          add(j,k,-1,1,0);
+        }
+        else if(i==j){
+          add(j+1,k,1,0,0);
+        }
+        else if(i==k-1){
+          add(j,i,1,1,0);
+          add(j,k,1,0,0);
+          add(j,k,-1,1,0);
+          add(i,k,-1,2,1);
+          add(i,k,1,1,1);
+        }
+        else if(i==k){
+          add(j,k+1,1,0,0);
+        }
+        else{
+          //Identity column, not stored
+          continue;
+        }
+        columns[i-1].push_back(col);
+        a.append_column(v,N);
+      }
+    }
+    const vector<size_t>& cols=columns[i-1];
+    width=max(width,cols.size());
+    for(size_t c=0;c<N;++c) position[c]=N;
+    for(size_t b=0;b<cols.size();++b) position[cols[b]]=b;
+    //The image of a(i) cancels (x-1)(x+q)(x+tq^2). A listed column a.e(c)
+    //of a(i) gives the column a(i)^2.e(c)+c1.a(i).e(c)+c0.e(c) of b.
+    LKGenerator& b=negative[i-1];
+    for(size_t x=0;x<cols.size();++x){
+      for(size_t e=a.starts[x];e<a.starts[x+1];++e){
+        size_t k=a.rows[e];
+        const fmpz_poly_struct* f=&a.entries[e];
+        size_t y=position[k];
+        if(y==N) fmpz_poly_add(&v[k],&v[k],f);
+        else{
+          for(size_t h=a.starts[y];h<a.starts[y+1];++h){
+            fmpz_poly_mul(p,f,&a.entries[h]);
+            fmpz_poly_add(&v[a.rows[h]],&v[a.rows[h]],p);
+          }
+        }
+        fmpz_poly_mul(p,f,c1);
+        fmpz_poly_add(&v[k],&v[k],p);
+      }
+      fmpz_poly_add(&v[cols[x]],&v[cols[x]],c0);
+      b.append_column(v,N);
+    }
+  }
+  for(size_t r=0;r<N;++r) fmpz_poly_clear(&v[r]);
+  delete[] v;
+  fmpz_poly_clear(c0);
+  fmpz_poly_clear(c1);
+  fmpz_poly_clear(p);
+}
+
+//-------------------------------------
+// LawrenceKrammer::~LawrenceKrammer()
+//-------------------------------------
+
+LawrenceKrammer::~LawrenceKrammer(){
+  delete[] positive;
+  delete[] negative;
+  delete[] columns;
+  for(size_t k=0;k<LK_SPREADS;++k){
+    LKGenerator* g=spreads[k];
+    if(g!=nullptr) delete[] g;
+  }
+}
+
+//----------------------------------------------------------
+// LawrenceKrammer::are_equivalent(const Word&,const Word&)
+//----------------------------------------------------------
+
+bool
+LawrenceKrammer::are_equivalent(const Word& u,const Word& v){
+  size_t n=2;
+  slong pu=0,mu=0,pv=0,mv=0;
+  for(size_t i=0;i<u.size();++i){
+    Generator x=u.read(i);
+    n=max(n,(size_t)abs(x)+1);
+    if(x>0) ++pu;
+    else ++mu;
+  }
+  for(size_t i=0;i<v.size();++i){
+    Generator x=v.read(i);
+    n=max(n,(size_t)abs(x)+1);
+    if(x>0) ++pv;
+    else ++mv;
+  }
+  //Exponent sum is an invariant
+  if(pu-mu!=pv-mv) return false;
+  const LawrenceKrammer* lk=get(n);
+  LawrenceKrammer* owned=nullptr;
+  if(lk==nullptr) lk=owned=new LawrenceKrammer(n);
+  //Images of u and v are multiplied by (tq^3)^(mu+mv), so that entries have
+  //degree in q at most 2pu+4mu+3mv and 2pv+4mv+3mu. The exponent d of t is
+  //rounded to a power of two so that spread generators can be reused.
+  slong e=max(2*pu+4*mu+3*mv,2*pv+4*mv+3*mu)+1;
+  size_t k=0;
+  while((slong(1)<<k)<max(e,(slong)LK_GENERATOR_SHIFT)) ++k;
+  slong d=slong(1)<<k;
+  fmpz_poly_mat_t iu,iv;
+  fmpz_poly_mat_init(iu,lk->N,lk->N);
+  fmpz_poly_mat_init(iv,lk->N,lk->N);
+  lk->image(iu,u,k);
+  lk->image(iv,v,k);
+  for(size_t i=0;i<lk->N;++i){
+    for(size_t j=0;j<lk->N;++j){
+      fmpz_poly_struct* e=fmpz_poly_mat_entry(iu,i,j);
+      fmpz_poly_shift_left(e,e,mv*(d+3));
+      e=fmpz_poly_mat_entry(iv,i,j);
+      fmpz_poly_shift_left(e,e,mu*(d+3));
+    }
+  }
+  bool res=fmpz_poly_mat_equal(iu,iv);
+  fmpz_poly_mat_clear(iu);
+  fmpz_poly_mat_clear(iv);
+  if(owned!=nullptr) delete owned;
+  return res;
+}
+
+//------------------------------
+// LawrenceKrammer::get(size_t)
+//------------------------------
+
+const LawrenceKrammer*
+LawrenceKrammer::get(size_t n){
+  if(n>LK_MAX_STRANDS) return nullptr;
+  LawrenceKrammer* lk=lawrence_krammers[n];
+  if(lk!=nullptr) return lk;
+  lock_guard<mutex> lock(lawrence_krammers_mutex);
+  lk=lawrence_krammers[n];
+  if(lk==nullptr){
+    lk=new LawrenceKrammer(n);
+    lawrence_krammers[n]=lk;
+  }
+  return lk;
+}
+
+//------------------------------------------------------------
+// LawrenceKrammer::image(fmpz_poly_mat_t,const Word&,size_t)
+//------------------------------------------------------------
+
+void
+LawrenceKrammer::image(fmpz_poly_mat_t res,const Word& w,size_t e) const{
+  //Generator matrices with t=z^d
+  slong d=slong(1)<<e;
+  const LKGenerator* pos=spread_generators(e);
+  const LKGenerator* neg=pos+(n-1);
+  size_t l=w.size();
+  size_t chunks=thread_pool().size();
+  if(chunks>l/LK_CHUNK) chunks=l/LK_CHUNK;
+  if(chunks==0) chunks=1;
+  //Each chunk is multiplied letter by letter, a letter acting on few columns
+  fmpz_poly_mat_struct* m=new fmpz_poly_mat_struct[chunks];
+  parallel_for(chunks,[&](size_t i){
+    fmpz_poly_mat_t tmp;
+    fmpz_poly_mat_init(tmp,N,width);
+    fmpz_poly_mat_init(&m[i],N,N);
+    fmpz_poly_mat_one(&m[i]);
+    for(size_t k=i*l/chunks;k<(i+1)*l/chunks;++k){
+      Generator x=w.read(k);
+      if(x>0) right_multiply(&m[i],x-1,pos[x-1],0,tmp);
+      else right_multiply(&m[i],-x-1,neg[-x-1],d+3,tmp);
+    }
+    fmpz_poly_mat_clear(tmp);
+  });
+  //Chunk images are multiplied along a balanced tree
+  for(size_t step=1;step<chunks;step*=2){
+    parallel_for((chunks+step-1)/(2*step),[&](size_t k){
+      size_t a=2*step*k;
+      size_t b=a+step;
+      if(b<chunks) fmpz_poly_mat_mul(&m[a],&m[a],&m[b]);
+    });
+  }
+  fmpz_poly_mat_swap(res,&m[0]);
+  for(size_t i=0;i<chunks;++i) fmpz_poly_mat_clear(&m[i]);
+  delete[] m;
+}
+
+//--------------------------------------------------------------------------------------------------
+// LawrenceKrammer::right_multiply(fmpz_poly_mat_t,size_t,const LKGenerator&,slong,fmpz_poly_mat_t)
+//--------------------------------------------------------------------------------------------------
+
+void
+LawrenceKrammer::right_multiply(fmpz_poly_mat_t m,size_t i,const LKGenerator& g,slong s,fmpz_poly_mat_t tmp) const{
+  const vector<size_t>& cols=columns[i];
+  fmpz_poly_t p;
+  fmpz_poly_init(p);
+  //New columns depend on old ones, they are computed in tmp first
+  for(size_t a=0;a<cols.size();++a){
+    for(size_t r=0;r<N;++r) fmpz_poly_zero(fmpz_poly_mat_entry(tmp,r,a));
+    for(size_t h=g.starts[a];h<g.starts[a+1];++h){
+      size_t k=g.rows[h];
+      const fmpz_poly_struct* e=&g.entries[h];
+      for(size_t r=0;r<N;++r){
+        const fmpz_poly_struct* f=fmpz_poly_mat_entry(m,r,k);
+        if(fmpz_poly_is_zero(f)) continue;
+        fmpz_poly_mul(p,f,e);
+        fmpz_poly_struct* t=fmpz_poly_mat_entry(tmp,r,a);
+        fmpz_poly_add(t,t,p);
+      }
+    }
+  }
+  if(s>0){
+    //Columns are sorted, other ones are multiplied by z^s
+    size_t a=0;
+    for(size_t c=0;c<N;++c){
+      if(a<cols.size() and cols[a]==c){
+        ++a;
+        continue;
+      }
+      for(size_t r=0;r<N;++r){
+        fmpz_poly_struct* e=fmpz_poly_mat_entry(m,r,c);
+        fmpz_poly_shift_left(e,e,s);
+      }
+    }
+  }
+  for(size_t a=0;a<cols.size();++a){
+    for(size_t r=0;r<N;++r){
+      fmpz_poly_swap(fmpz_poly_mat_entry(m,r,cols[a]),fmpz_poly_mat_entry(tmp,r,a));
+    }
+  }
+  fmpz_poly_clear(p);
+}
+
+//--------------------------------------------
+// LawrenceKrammer::spread_generators(size_t)
+//--------------------------------------------
+
+const LKGenerator*
+LawrenceKrammer::spread_generators(size_t k) const{
+  LKGenerator* g=spreads[k];
+  if(g!=nullptr) return g;
+  lock_guard<mutex> lock(spreads_mutex);
+  g=spreads[k];
+  if(g!=nullptr) return g;
+  slong d=slong(1)<<k;
+  g=new LKGenerator[2*(n-1)];
+  for(size_t i=0;i<n-1;++i){
+    g[i].set_spread(positive[i],d);
+    g[i+n-1].set_spread(negative[i],d);
+  }
+  spreads[k]=g;
+  return g;
+}
@@ -0,0 +1,165 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LAWRENCE_KRAMMER_HPP
+#define LAWRENCE_KRAMMER_HPP
+
+#include <atomic>
+#include <mutex>
+#include "flint/fmpz_poly.h"
+#include "flint/fmpz_poly_mat.h"
+#include "monoid.hpp"
+
+//! Exponent of z substituted to t in precomputed generator matrices, which
+//! have degree in q less than it
+#define LK_GENERATOR_SHIFT 8
+
+//! Maximal number of strands of cached representations
+#define LK_MAX_STRANDS 32
+
+//! Minimal number of letters of a chunk multiplied by a single thread
+#define LK_CHUNK 64
+
+//! Number of cached spreads of generator matrices, the k-th one having
+//! t=z^(2^k)
+#define LK_SPREADS 64
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Image of a generator whose columns not listed in LawrenceKrammer::columns
+//! are those of a scalar matrix. Only non zero entries of listed columns are
+//! stored, column after column.
+class LKGenerator{
+public:
+  //! Entries of the a-th listed column have index in [starts[a],starts[a+1])
+  vector<size_t> starts;
+  //! Row of each entry
+  vector<size_t> rows;
+  //! Value of each entry
+  vector<fmpz_poly_struct> entries;
+
+  //! Construct a generator with no listed column
+  LKGenerator();
+
+  //! No copy constructor
+  LKGenerator(const LKGenerator&)=delete;
+
+  //! Destructor
+  ~LKGenerator();
+
+  //! Append a column whose entries are those of v, of size N, which are
+  //! moved so that v is left zero
+  void append_column(fmpz_poly_struct* v,size_t N);
+
+  //! No copy assignement
+  LKGenerator& operator=(const LKGenerator&)=delete;
+
+  //! Set the generator to g where z^LK_GENERATOR_SHIFT is replaced by z^d
+  void set_spread(const LKGenerator& g,slong d);
+};
+
+//! Lawrence-Krammer representation of braids of type A on n strands, which
+//! is faithful. We follow Bigelow's formulas on the basis v(j,k) with
+//! 1<=j<k<=n. Entries lie in Z[q,t] as the image of a(i)^-1 is multiplied
+//! by tq^3 : it is then a(i)^2+(q+tq^2-1)a(i)+(tq^3-q-tq^2). Both variables
+//! are encoded in fmpz_poly by Kronecker substitution q=z and t=z^d, with
+//! d larger than the degree in q of compared matrices.
+class LawrenceKrammer{
+public:
+  //! Number of strands
+  size_t n;
+  //! Dimension of the representation, that is n(n-1)/2
+  size_t N;
+  //! Images of a(i) for i=1..n-1, with d=LK_GENERATOR_SHIFT
+  LKGenerator* positive;
+  //! Images of a(i)^-1 multiplied by tq^3, with d=LK_GENERATOR_SHIFT
+  LKGenerator* negative;
+  //! Columns of the image of a(i) differing from identity ones, the other
+  //! columns of the scaled image of a(i)^-1 being those of tq^3.Id
+  vector<size_t>* columns;
+  //! Maximal number of non trivial columns of a generator
+  size_t width;
+  //! Images of generators with t=z^(2^k) for k<LK_SPREADS, positive ones
+  //! followed by negative ones, built on demand by spread_generators
+  mutable atomic<LKGenerator*> spreads[LK_SPREADS];
+  //! Serialise the building of spreads
+  mutable mutex spreads_mutex;
+
+  //! Construct the representation on n strands
+  LawrenceKrammer(size_t n);
+
+  //! No copy constructor
+  LawrenceKrammer(const LawrenceKrammer&)=delete;
+
+  //! Destructor
+  ~LawrenceKrammer();
+
+  //! Test if two words of type A are equivalent
+  static bool are_equivalent(const Word& u,const Word& v);
+
+  //! Return the cached representation on n strands, nullptr if n is
+  //! larger than LK_MAX_STRANDS
+  static const LawrenceKrammer* get(size_t n);
+
+  //! Set res, a NxN matrix, to the image of w multiplied by (tq^3)^m where
+  //! m is the number of negative letters of w, with t=z^(2^k). The word is
+  //! split into chunks whose images are multiplied along a balanced tree.
+  void image(fmpz_poly_mat_t res,const Word& w,size_t k) const;
+
+  //! Return the index of v(j,k)
+  size_t index(size_t j,size_t k) const;
+
+  //! No copy assignement
+  LawrenceKrammer& operator=(const LawrenceKrammer&)=delete;
+
+  //! Replace m by m.g where g is the image of a(i+1) or the scaled image of
+  //! its inverse, whose columns not in columns[i] are those of z^s.Id. The
+  //! matrix tmp, of size Nxwidth, is used as workspace.
+  void right_multiply(fmpz_poly_mat_t m,size_t i,const LKGenerator& g,slong s,fmpz_poly_mat_t tmp) const;
+
+  //! Return the images of generators with t=z^(2^k), positive ones
+  //! followed by negative ones, which are built at the first call
+  const LKGenerator* spread_generators(size_t k) const;
+};
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//-------------
+// LKGenerator
+//-------------
+
+inline
+LKGenerator::LKGenerator(){
+  starts.push_back(0);
+}
+
+//-----------------
+// LawrenceKrammer
+//-----------------
+
+inline size_t
+LawrenceKrammer::index(size_t j,size_t k) const{
+  return ((k-1)*(k-2))/2+j-1;
+}
+
+#endif
@@ -17,302 +17,144 @@
  * along with Gomu. If not, see <http://www.gnu.org/licenses/>. 
  */
 
+#include "../../module.hpp"
 #include "monoid.hpp"
+#include "conjugacy.hpp"
+#include "lattice.hpp"
 
-//*************
-//* Reversing *
-//*************
-
-Word
-Reversing::get_word() const{
-  size_t s=word.size;
-  Word res(s);
-  if(s==0) return res;
-  NInd ind=word.nodes[0].next;
-  res[0]=word.nodes[ind].data;
-  size_t i=1;
-  while((ind=word.nodes[ind].next)!=0){
-    res[i++]=word.nodes[ind].data;
-  }
-  return res;
-}
-
-//*****************
-//* LeftReversing *
-//*****************
-
-//-----------------------------------
-// LeftReversing::check_positivity()
-//-----------------------------------
-
-bool
-LeftReversing::check_positivity(){
-  while(not to_reverse.empty()){
-    reverse();
-    if(word.size>0 and word.first()<0) return false;
-  }
-  return true;
-}
-
-//------------------------------
-// LeftReversing::denominator()
-//------------------------------
-
-Word
-LeftReversing::denominator(){
-  size_t ind=word.nodes[0].next;
-  if(ind==0 or word.nodes[ind].data>0) return Word();
-  size_t s=1;
-  while((ind=word.nodes[ind].next)!=0 and word.nodes[ind].data<0){ 
-    ++s;
-  }
-  Word res(s);
-  s=0;
-  while((ind=word.nodes[ind].previous)!=0){
-    res[s++]=-word.nodes[ind].data;
-  }
-  return res;
-}
+//******************
+//* Global objects *
+//******************
 
-//----------------------------
-// LeftReversing::numerator()
-//----------------------------
+thread_local ThreadReversings thread_reversings;
+atomic<size_t> MonoidTrait::engines_counter(0);
 
-Word
-LeftReversing::numerator(){
-  size_t ind=word.nodes[0].previous;
-  if(ind==0 or word.nodes[ind].data<0) return Word();
-  size_t s=1;
-  while((ind=word.nodes[ind].previous)!=0 and word.nodes[ind].data>0){ 
-    ++s;
-  }
-  Word res(s);
-  s=0;
-  while((ind=word.nodes[ind].next)!=0){
-    res[s++]=word.nodes[ind].data;
-  }
-  return res;
-}
+//*******************
+//* ComplementTable *
+//*******************
 
-//--------------------------
-// LeftReversing::reverse()
-//--------------------------
+//---------------------------------------------------------------------
+// ComplementTable::init(size_t,size_t,SetComplement,IndexedGenerator)
+//---------------------------------------------------------------------
 
 void
-LeftReversing::reverse(){
-  //replace ___x.Y___ by ___U.v___
-  NInd i=to_reverse.back();
-  to_reverse.pop_back();
-  Generator x=word.nodes[i].data;
-  NInd j=word.nodes[i].next;
-  NInd p=word.nodes[i].previous;
-  Generator y=-word.nodes[j].data;
-  NInd n=word.nodes[j].next;
-  //the word is __$.x.Y.#__ with $=[p],X=[i],y=[j],#=[n]
-  size_t s=set_comp(x,y,comp);
-  //TODO :: Unroll loop
-  for(size_t ind=0;ind<s;++ind){
-    word.insert_after(i,-comp[ind]);
-  }
-  word.erase(i);
-  s=set_comp(y,x,comp);
-  for(size_t ind=0;ind<s;++ind) word.insert_before(j,comp[ind]);
-  word.erase(j);
-
-  //the word is now __$.U.v.#___ with $=[p] and #=[n]
-  if(s>0){
-    if(word.nodes[p].data>0){
-      if(word.nodes[word.nodes[p].next].data<0){
-	to_reverse.push_back(p);
-      }
-    }
-    if(word.nodes[n].data<0){
-      if(word.nodes[word.nodes[n].previous].data>0){
-	to_reverse.push_back(word.nodes[n].previous);
-      }
+ComplementTable::init(size_t r,size_t nb,SetComplement sc,IndexedGenerator ig){
+  if(index!=nullptr) delete[] index;
+  if(offsets!=nullptr) delete[] offsets;
+  if(letters!=nullptr) delete[] letters;
+  rank=r;
+  n=nb;
+  Generator* gens=new Generator[n];
+  bound=0;
+  for(size_t i=0;i<n;++i){
+    gens[i]=ig(i);
+    if(gens[i]>0 and (size_t)gens[i]>=bound) bound=gens[i]+1;
+  }
+  index=new uint16_t[bound];
+  for(size_t x=0;x<bound;++x) index[x]=absent;
+  for(size_t i=0;i<n;++i) index[gens[i]]=i;
+  //First pass computes offsets, the second fills letters
+  Generator comp[MAX_COMPLEMENT_SIZE];
+  offsets=new uint32_t[n*n+1];
+  offsets[0]=0;
+  for(size_t i=0;i<n;++i){
+    for(size_t j=0;j<n;++j){
+      size_t k=i*n+j;
+      offsets[k+1]=offsets[k]+sc(gens[i],gens[j],comp);
     }
   }
-  else{
-    if(word.nodes[p].data>0 and word.nodes[n].data<0){
-      to_reverse.push_back(p);
+  letters=new Generator[offsets[n*n]];
+  for(size_t i=0;i<n;++i){
+    for(size_t j=0;j<n;++j){
+      sc(gens[i],gens[j],letters+offsets[i*n+j]);
     }
   }
+  delete[] gens;
 }
 
-//----------------------------------------
-// LeftReversing::set_word(const Word& w)
-//----------------------------------------
-
-void
-LeftReversing::set_word(const Word& w){
-  clear();
-  Reversing::set_word(w);
-  if(w.is_empty()) return;
-  for(size_t i=0;i<w.size()-1;++i){
-    if(w.read(i)>0 and w.read(i+1)<0){
-      to_reverse.push_back(i+1); 
-    }
-  }
-}
-
-//----------------------------------------------------------
-// LeftReversing::set_word(const Word& num,const Word& den)
-//----------------------------------------------------------
-
-void
-LeftReversing::set_word(const Word& num,const Word& den){
-  clear();
-  size_t ns=num.size();
-  size_t ds=den.size();
-  Reversing::init_word(ns+ds);
-  for(int i=0;i<ns;++i){
-    word.nodes[i+1].data=num[i];
-  }
-  for(int i=0;i<ds;++i){
-    word.nodes[i+ns+1].data=-den[ds-i-1];
-  }
-  if(ns*ds!=0) to_reverse.push_back(ns);
-}
-
-//******************
-//* RightReversing *
-//******************
+//*************
+//* Reversing *
+//*************
 
-//------------------------------------
-// RightReversing::check_positivity()
-//------------------------------------
+//-------------------------------------------------
+// Reversing::free_reduce(const Word& w,bool left)
+//-------------------------------------------------
 
-bool
-RightReversing::check_positivity(){
-  while(not to_reverse.empty()){
-    reverse();
-    if(word.size>0 and word.last()<0) return false;
+size_t
+Reversing::free_reduce(const Word& w,bool left){
+  const Generator* x=w.array;
+  size_t s=w.size();
+  size_t j=free_reduction?word_find_cancellation(x,0,s):s;
+  if(j==s){
+    Reversing::set_word(w);
+    return s;
+  }
+  //Stack based reduction, letters between two cancellations of w being
+  //pushed as a block ; the top of the stack is reduction[m-1]
+  reduction.resize(s);
+  Generator* r=reduction.data();
+  size_t m=0;
+  size_t i=0;
+  while(i<s){
+    while(i<s and m>0 and r[m-1]+x[i]==0 and (r[m-1]>0)==left){
+      --m;
+      ++i;
+    }
+    j=i;
+    while((j=word_find_cancellation(x,j,s))<s and (x[j]>0)!=left) ++j;
+    copy(x+i,x+j,r+m);
+    m+=j-i;
+    i=(j<s)?j+2:s;
   }
-  return true;
+  reduced+=s-m;
+  word.init((NData*)r,m);
+  return m;
 }
 
-//-------------------------------
-// RightReversing::denominator()
-//-------------------------------
+//-----------------------
+// Reversing::get_word()
+//-----------------------
 
 Word
-RightReversing::denominator(){
-  size_t ind=word.nodes[0].previous;
-  if(ind==0 or word.nodes[ind].data>0) return Word();
-  size_t s=1;
-  while((ind=word.nodes[ind].previous)!=0 and word.nodes[ind].data<0){ 
-    ++s;
-  }
+Reversing::get_word() const{
+  size_t s=word.size;
   Word res(s);
-  size_t i=0;
+  if(s==0) return res;
+  NInd ind=word.nodes[0].next;
+  res[0]=word.nodes[ind].data;
+  size_t i=1;
   while((ind=word.nodes[ind].next)!=0){
-    res[s-i-1]=-word.nodes[ind].data;
-    ++i;
+    res[i++]=word.nodes[ind].data;
   }
   return res;
 }
 
-//-----------------------------
-// RightReversing::numerator()
-//-----------------------------
+//-------------------------------------
+// Reversing::sign_run(bool,bool,bool)
+//-----------------------------------------
 
 Word
-RightReversing::numerator(){
-  size_t ind=word.nodes[0].next;
-  if(ind==0 or word.nodes[ind].data<0) return Word();
-  size_t s=1;
-  while((ind=word.nodes[ind].next)!=0 and word.nodes[ind].data>0){ 
+Reversing::sign_run(bool at_end,bool positive,bool invert) const{
+  const StackedListNode* nodes=word.nodes;
+  //Letters are read from the extremity of the word towards its middle
+  NInd start=at_end?nodes[0].previous:nodes[0].next;
+  NInd ind=start;
+  size_t s=0;
+  while(ind!=0 and (nodes[ind].data>0)==positive){
     ++s;
+    ind=at_end?nodes[ind].previous:nodes[ind].next;
   }
   Word res(s);
-  size_t i=0;
-  while((ind=word.nodes[ind].previous)!=0){
-    res[s-i-1]=word.nodes[ind].data;
-    ++i;
+  ind=start;
+  for(size_t i=0;i<s;++i){
+    //Reading from the end reverses the run, as does inversion
+    size_t k=(at_end!=invert)?s-1-i:i;
+    res[k]=invert?-nodes[ind].data:nodes[ind].data;
+    ind=at_end?nodes[ind].previous:nodes[ind].next;
   }
   return res;
 }
 
-//---------------------------
-// RightReversing::reverse()
-//---------------------------
-
-void RightReversing::reverse(){
-  //replace ___X.y___ by ___u.V___
-  NInd i=to_reverse.back();
-  to_reverse.pop_back();
-  Generator x=-word.nodes[i].data;
-  NInd j=word.nodes[i].next;
-  NInd p=word.nodes[i].previous;
-  Generator y=word.nodes[j].data;
-  NInd n=word.nodes[j].next;
-
-  //the word is __$.X.y.#__ with $=[p],X=[i],y=[j],#=[n]
-  size_t s=set_comp(x,y,comp);
-  //TODO :: Unroll loop
-  for(size_t ind=0;ind<s;++ind) word.insert_before(i,comp[ind]);
-  word.erase(i);
-  s=set_comp(y,x,comp);
-  for(size_t ind=0;ind<s;++ind) word.insert_after(j,-comp[ind]);
-  word.erase(j);
-  
-  //the word is now __$.u.V.#___ with $=[p] and #=[n]
-  if(s>0){
- 
-    if(word.nodes[p].data<0){
-      if(word.nodes[word.nodes[p].next].data>0){
-	to_reverse.push_back(p);
-      }
-    }
-    if(word.nodes[n].data>0){
-      if(word.nodes[word.nodes[n].previous].data<0){
-	to_reverse.push_back(word.nodes[n].previous);
-      }
-    }
-  }
-  else{
-    if(word.nodes[p].data<0 and word.nodes[n].data>0){
-      to_reverse.push_back(p);
-    }
-  }
-}
-
-//-----------------------------------------
-// RightReversing::set_word(const Word& w)
-//-----------------------------------------
-
-void
-RightReversing::set_word(const Word& w){
-  clear();
-  Reversing::set_word(w);
-  if(w.is_empty()) return;
-  for(size_t i=0;i<w.size()-1;++i){
-    if(w.read(i)<0 and w.read(i+1)>0){
-      to_reverse.push_back(i+1); 
-    }
-  }
-}
-
-//----------------------------------------------------------
-// RightReversing::set_word(const Word& num,const Word& den)
-//----------------------------------------------------------
-
-void
-RightReversing::set_word(const Word& den,const Word& num){
-  clear();
-  size_t ds=den.size();
-  size_t ns=num.size();
-  Reversing::init_word(ds+ns);
-  for(int i=0;i<ds;++i){
-    word.nodes[i+1].data=-den[ds-i-1];
-  }
-  for(int i=0;i<ns;++i){
-    word.nodes[i+ds+1].data=num[i];
-  }
-  if(ns*ds!=0) to_reverse.push_back(ds);
-}
-
-
 //****************
 //* MonoidFamily *
 //****************
@@ -326,6 +168,26 @@ MonoidFamily::MonoidFamily(string l,DisplayGenerator d,GeneratorsNumber n,Genera
   right_reversing=nullptr;
   ranked_phi_germ=nullptr;
   ranked_garside_word_factory=nullptr;
+  ranked_garside_normal_form=nullptr;
+  garside_normal_form_rank=0;
+  ranked_garside_power=nullptr;
+  ranked_lattice_factory=nullptr;
+  lattice_rank=0;
+  for(size_t r=0;r<=MAX_LATTICE_RANK;++r) lattices[r]=nullptr;
+  ranked_conjugacy_factory=nullptr;
+  conjugacy_rank=0;
+  indexed_generator=nullptr;
+}
+
+//-------------------------------
+// MonoidFamily::~MonoidFamily()
+//-------------------------------
+
+MonoidFamily::~MonoidFamily(){
+  for(size_t r=0;r<=MAX_LATTICE_RANK;++r){
+    SimpleLattice* lattice=lattices[r];
+    if(lattice!=nullptr) delete lattice;
+  }
 }
 
 //------------------------------------------
@@ -336,8 +198,34 @@ void
 MonoidFamily::apply_phi(size_t r,Word& w,int p){
   size_t s=w.size();
   for(size_t i=0;i<s;++i){
-    w[i]=ranked_phi_germ(r,w[i],p);
+    w.array[i]=ranked_phi_germ(r,w.array[i],p);
   }
+  w.fingerprint=0;
+}
+
+//----------------------------------------
+// MonoidFamily::conjugacy_engine(size_t)
+//----------------------------------------
+
+ConjugacyEngine*
+MonoidFamily::conjugacy_engine(size_t r){
+  //Tabulated simple elements are a fast path for small ranks
+  SimpleLattice* lattice=simple_lattice(r);
+  if(lattice!=nullptr) return new GarsideConjugacy<LatticeSimples>(LatticeSimples(lattice));
+  if(ranked_conjugacy_factory==nullptr or r>conjugacy_rank) return nullptr;
+  return ranked_conjugacy_factory(r);
+}
+
+//-------------------------------------------------------
+// MonoidFamily::garside_normal_form(size_t,const Word&)
+//-------------------------------------------------------
+
+Word
+MonoidFamily::garside_normal_form(size_t r,const Word& w){
+  //Tables of simple elements avoid recomputing products and meets
+  SimpleLattice* lattice=simple_lattice(r);
+  if(lattice!=nullptr) return lattice->normal_form(w);
+  return ranked_garside_normal_form(r,w);
 }
 
 //------------------------------------
@@ -367,15 +255,9 @@ MonoidFamily::phi_normal(size_t r,const Word& w){
     splitting[i]=phi_normal(r-1,splitting[i]);
     apply_phi(r,splitting[i],b-1-i);
   }
-  Word res(w.size());
-  size_t ind=0;
-  for(size_t i=0;i<b;++i){
-    Word& temp=splitting[i];
-    for(size_t j=0;j<temp.size();++j){
-      res[ind++]=temp[j];
-    }
-  }
-  return res;
+  WordBuilder res(w.size());
+  for(size_t i=0;i<b;++i) res.append(splitting[i]);
+  return res.word();
 }
 
 //-------------------------------------
@@ -385,15 +267,14 @@ MonoidFamily::phi_normal(size_t r,const Word& w){
 Word
 MonoidFamily::phi_tail(size_t r,const Word& w){
   Word u=w;
-  Word res;
+  WordBuilder res;
   Word delta=garside_element(r);
   while(true){
     pair<Word,Word> temp=right_gcd_x(u,delta);
-    if(temp.first.is_empty()) return res;
-    res=res*temp.first;
-    u=temp.second;
+    if(temp.first.is_empty()) return res.word();
+    res.append(temp.first);
+    u=move(temp.second);
   }
-  return res;
 }
 
 //---------------------------------------
@@ -403,15 +284,14 @@ MonoidFamily::phi_tail(size_t r,const Word& w){
 pair<Word,Word>
 MonoidFamily::phi_tail_x(size_t r,const Word& w){
   Word u=w;
-  Word res;
+  WordBuilder res;
   Word delta=garside_element(r);
   while(true){
     pair<Word,Word> temp=right_gcd_x(u,delta);
-    if(temp.first.is_empty()) return pair<Word,Word>(u,res);
-    res=res*temp.first;
-    u=temp.second;
+    if(temp.first.is_empty()) return pair<Word,Word>(move(u),res.word());
+    res.append(temp.first);
+    u=move(temp.second);
   }
-  return pair<Word,Word>(u,res);
 }
 
 //------------------------------------------
@@ -425,13 +305,32 @@ MonoidFamily::phi_splitting(size_t r,const Word& w){
   while(not u.is_empty()){
     pair<Word,Word> p=phi_tail_x(r,u);
     u=phi(r+1,p.first,-1);
-    res.push_front(p.second);
+    res.push_front(move(p.second));
   }
   Array<Word> res_array(res.size());
-  for(size_t i=0;i<res.size();++i) res_array[i]=res[i];
+  for(size_t i=0;i<res.size();++i) res_array[i]=move(res[i]);
   return res_array;
 }
 
+//-------------------------------------------------
+// MonoidFamily::power(size_t,const Word&,int64_t)
+//-------------------------------------------------
+
+Word
+MonoidFamily::power(size_t r,const Word& w,int64_t k){
+  if(ranked_garside_power!=nullptr and r<=garside_normal_form_rank){
+    return ranked_garside_power(r,w,k);
+  }
+  Word x=(k<0)?w.inverse():w;
+  uint64_t e=(k<0)?-(uint64_t)k:k;
+  if(not x.is_empty() and e>MAX_WORD_SIZE/x.size()){
+    RuntimeError("Power is too large");
+  }
+  WordBuilder res(x.size()*e);
+  for(uint64_t i=0;i<e;++i) res.append(x);
+  return res.word();
+}
+
 //--------------------------
 // MonoidFamily::rank(Word)
 //--------------------------
@@ -447,6 +346,63 @@ MonoidFamily::rank(const Word& w){
   return r;
 }
 
+//--------------------------------------
+// MonoidFamily::simple_lattice(size_t)
+//--------------------------------------
+
+SimpleLattice*
+MonoidFamily::simple_lattice(size_t r){
+  if(ranked_lattice_factory==nullptr or r>lattice_rank) return nullptr;
+  SimpleLattice* lattice=lattices[r];
+  if(lattice!=nullptr) return lattice;
+  //Lattices are built once, the first thread asking for it doing the job
+  lock_guard<mutex> lock(lattices_mutex);
+  lattice=lattices[r];
+  if(lattice==nullptr){
+    lattice=ranked_lattice_factory(r);
+    lattices[r]=lattice;
+  }
+  return lattice;
+}
+
+//--------------------------------------------
+// MonoidFamily::tabulate_complements(size_t)
+//--------------------------------------------
+
+void
+MonoidFamily::tabulate_complements(size_t r){
+  if(indexed_generator==nullptr) return;
+  size_t n=gnum(r+1);
+  if(n>MAX_TABULATED_GENERATORS) return;
+  if(left_reversing!=nullptr and left_table.rank<r){
+    left_table.init(r,n,left_reversing->set_comp,indexed_generator);
+    left_reversing->table=&left_table;
+  }
+  if(right_reversing!=nullptr and right_table.rank<r){
+    right_table.init(r,n,right_reversing->set_comp,indexed_generator);
+    right_reversing->table=&right_table;
+  }
+  //Engines of threads must be cloned again to see the tables
+  engines_id=engines_counter++;
+}
+
+//********************
+//* ThreadReversings *
+//********************
+
+//---------------------------------------
+// ThreadReversings::~ThreadReversings()
+//---------------------------------------
+
+ThreadReversings::~ThreadReversings(){
+  for(size_t i=0;i<left.size();++i){
+    if(left[i]!=nullptr) delete left[i];
+  }
+  for(size_t i=0;i<right.size();++i){
+    if(right[i]!=nullptr) delete right[i];
+  }
+}
+
 //***************
 //* MonoidTrait *
 //***************
@@ -458,6 +414,8 @@ MonoidFamily::rank(const Word& w){
 MonoidTrait::MonoidTrait(){
   left_reversing=nullptr;
   right_reversing=nullptr;
+  engines_id=engines_counter++;
+  free_reduction=true;
 }
 //-----------------------------
 // MonoidTrait::~MonoidTrait()
@@ -474,9 +432,27 @@ MonoidTrait::~MonoidTrait(){
 
 bool
 MonoidTrait::are_equivalent(const Word& u,const Word& v){
-  left_reversing->set_word(u,v);
-  left_reversing->check_positivity();
-  return left_reversing->word.is_empty();
+  SimpleLattice* lattice=simple_lattice(u,v);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(u);
+    uint16_t j=lattice->index(v);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent) return i==j;
+  }
+  LeftReversing* lr=left_engine();
+  lr->set_word(u,v);
+  lr->check_positivity();
+  return lr->word.is_empty();
+}
+
+//--------------------------------------------------------------------
+// MonoidTrait::are_equivalent(const Array<Word>&,const Array<Word>&)
+//--------------------------------------------------------------------
+
+Array<bool>
+MonoidTrait::are_equivalent(const Array<Word>& u,const Array<Word>& v){
+  Array<bool> res(u.size());
+  parallel_for(u.size(),[&](size_t i){res[i]=are_equivalent(u[i],v[i]);});
+  return res;
 }
 
 //-----------------------------------------------------------
@@ -485,8 +461,9 @@ MonoidTrait::are_equivalent(const Word& u,const Word& v){
 
 pair<bool,Word>
 MonoidTrait::is_left_divisible_x(const Word& a,const Word& b){
-  right_reversing->set_word(b,a);
-  if(right_reversing->check_positivity())
+  RightReversing* rr=right_engine();
+  rr->set_word(b,a);
+  if(rr->check_positivity())
     return pair<bool,Word>(true,right_numerator());
   return pair<bool,Word>(false,Word());
 }
@@ -497,8 +474,9 @@ MonoidTrait::is_left_divisible_x(const Word& a,const Word& b){
 
 pair<bool,Word>
 MonoidTrait::is_right_divisible_x(const Word& a,const Word& b){
-  left_reversing->set_word(a,b);
-  if(left_reversing->check_positivity())
+  LeftReversing* lr=left_engine();
+  lr->set_word(a,b);
+  if(lr->check_positivity())
     return pair<bool,Word>(true,left_numerator());
   return pair<bool,Word>(false,Word());
 }
@@ -522,25 +500,129 @@ MonoidTrait::left_complement(const Generator& x,const Generator& y){
 
 Word
 MonoidTrait::left_gcd(const Word& a,const Word& b){
+  SimpleLattice* lattice=simple_lattice(a,b);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(a);
+    uint16_t j=lattice->index(b);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent){
+      return lattice->words[lattice->left_gcd[i*lattice->size+j]];
+    }
+  }
   right_reverse(a,b);
-  left_reverse(right_reversing->get_word());
+  left_reverse(right_engine()->get_word());
   left_reverse(a,left_denominator());
   return left_numerator();
 }
 
+//--------------------------------------------------------------
+// MonoidTrait::left_gcd(const Array<Word>&,const Array<Word>&)
+//--------------------------------------------------------------
+
+Array<Word>
+MonoidTrait::left_gcd(const Array<Word>& a,const Array<Word>& b){
+  Array<Word> res(a.size());
+  parallel_for(a.size(),[&](size_t i){res[i]=left_gcd(a[i],b[i]);});
+  return res;
+}
+
 //--------------------------------------------------
 // MonoidTrait::left_gcd_x(const Word&,const Word&)
 //--------------------------------------------------
 
 pair<Word,Word>
 MonoidTrait::left_gcd_x(const Word& a,const Word& b){
+  SimpleLattice* lattice=simple_lattice(a,b);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(a);
+    uint16_t j=lattice->index(b);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent){
+      uint16_t g=lattice->left_gcd[i*lattice->size+j];
+      uint16_t d=lattice->left_quotient[g*lattice->size+i];
+      return pair<Word,Word>(lattice->words[g],lattice->words[d]);
+    }
+  }
   right_reverse(a,b);
-  left_reverse(right_reversing->get_word());
+  left_reverse(right_engine()->get_word());
   Word div=left_denominator();
   left_reverse(a,div);
   return pair<Word,Word>(left_numerator(),div);
 }
 
+//--------------------------------------------------------------
+// MonoidTrait::left_lcm(const Array<Word>&,const Array<Word>&)
+//--------------------------------------------------------------
+
+Array<Word>
+MonoidTrait::left_lcm(const Array<Word>& a,const Array<Word>& b){
+  Array<Word> res(a.size());
+  parallel_for(a.size(),[&](size_t i){res[i]=left_lcm(a[i],b[i]);});
+  return res;
+}
+
+//-----------------------------------------------
+// MonoidTrait::left_reverse(const Word&,size_t)
+//-----------------------------------------------
+
+Word
+MonoidTrait::left_reverse(const Word& w,size_t chunks){
+  if(chunks==0) chunks=thread_pool().size();
+  size_t l=w.size();
+  if(chunks>l/MIN_REVERSING_CHUNK) chunks=l/MIN_REVERSING_CHUNK;
+  if(chunks<2) return left_reverse(w);
+  //Each chunk is reversed into a fraction dens[i]^-1.nums[i]
+  Array<Word> nums(chunks),dens(chunks);
+  parallel_for(chunks,[&](size_t i){
+    LeftReversing* lr=left_engine();
+    lr->set_word(w.subword(i*l/chunks,(i+1)*l/chunks));
+    lr->full_reverse();
+    nums[i]=lr->numerator();
+    dens[i]=lr->denominator();
+  });
+  //Fractions D1^-1.N1 and D2^-1.N2 are merged by left reversing N1.D2^-1
+  //into X^-1.Y, their product being (X.D1)^-1.(Y.N2)
+  for(size_t step=1;step<chunks;step*=2){
+    parallel_for((chunks+step-1)/(2*step),[&](size_t k){
+      size_t a=2*step*k;
+      size_t b=a+step;
+      LeftReversing* lr=left_engine();
+      lr->set_word(nums[a],dens[b]);
+      lr->full_reverse();
+      dens[a]=lr->denominator().concatenate(dens[a]);
+      nums[a]=lr->numerator().concatenate(nums[b]);
+    });
+  }
+  return dens[0].inverse().concatenate(nums[0]);
+}
+
+//-----------------------------------------------------------
+// MonoidTrait::left_lcm_complement(const Word&,const Word&)
+//-----------------------------------------------------------
+
+Word
+MonoidTrait::left_lcm_complement(const Word& a,const Word& b){
+  SimpleLattice* lattice=simple_lattice(a,b);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(a);
+    uint16_t j=lattice->index(b);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent){
+      return lattice->words[lattice->left_lcm_complement(i,j)];
+    }
+  }
+  left_reverse(b,a);
+  return left_numerator();
+}
+
+//-----------------------------------------------
+// MonoidTrait::left_reverse(const Array<Word>&)
+//-----------------------------------------------
+
+Array<Word>
+MonoidTrait::left_reverse(const Array<Word>& ws){
+  Array<Word> res(ws.size());
+  parallel_for(ws.size(),[&](size_t i){res[i]=left_reverse(ws[i]);});
+  return res;
+}
+
 //----------------------------------------------------
 // MonoidTrait::right_complement(Generator,Generator)
 //----------------------------------------------------
@@ -560,25 +642,129 @@ MonoidTrait::right_complement(const Generator& x,const Generator& y){
 
 Word
 MonoidTrait::right_gcd(const Word& a,const Word& b){
+  SimpleLattice* lattice=simple_lattice(a,b);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(a);
+    uint16_t j=lattice->index(b);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent){
+      return lattice->words[lattice->right_gcd[i*lattice->size+j]];
+    }
+  }
   left_reverse(b,a);
-  right_reverse(left_reversing->get_word());
+  right_reverse(left_engine()->get_word());
   right_reverse(right_denominator(),a);
   return right_numerator();
 }
 
+//---------------------------------------------------------------
+// MonoidTrait::right_gcd(const Array<Word>&,const Array<Word>&)
+//---------------------------------------------------------------
+
+Array<Word>
+MonoidTrait::right_gcd(const Array<Word>& a,const Array<Word>& b){
+  Array<Word> res(a.size());
+  parallel_for(a.size(),[&](size_t i){res[i]=right_gcd(a[i],b[i]);});
+  return res;
+}
+
 //---------------------------------------------------
 // MonoidTrait::right_gcd_x(const Word&,const Word&)
 //---------------------------------------------------
 
 pair<Word,Word>
 MonoidTrait::right_gcd_x(const Word& a,const Word& b){
+  SimpleLattice* lattice=simple_lattice(a,b);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(a);
+    uint16_t j=lattice->index(b);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent){
+      uint16_t g=lattice->right_gcd[i*lattice->size+j];
+      uint16_t d=lattice->right_quotient[g*lattice->size+i];
+      return pair<Word,Word>(lattice->words[g],lattice->words[d]);
+    }
+  }
   left_reverse(b,a);
-  right_reverse(left_reversing->get_word());
+  right_reverse(left_engine()->get_word());
   Word div=right_denominator();
   right_reverse(div,a);
   return pair<Word,Word>(right_numerator(),div);
 }
 
+//---------------------------------------------------------------
+// MonoidTrait::right_lcm(const Array<Word>&,const Array<Word>&)
+//---------------------------------------------------------------
+
+Array<Word>
+MonoidTrait::right_lcm(const Array<Word>& a,const Array<Word>& b){
+  Array<Word> res(a.size());
+  parallel_for(a.size(),[&](size_t i){res[i]=right_lcm(a[i],b[i]);});
+  return res;
+}
+
+//------------------------------------------------------------
+// MonoidTrait::right_lcm_complement(const Word&,const Word&)
+//------------------------------------------------------------
+
+Word
+MonoidTrait::right_lcm_complement(const Word& a,const Word& b){
+  SimpleLattice* lattice=simple_lattice(a,b);
+  if(lattice!=nullptr){
+    uint16_t i=lattice->index(a);
+    uint16_t j=lattice->index(b);
+    if(i!=SimpleLattice::absent and j!=SimpleLattice::absent){
+      return lattice->words[lattice->right_lcm_complement(i,j)];
+    }
+  }
+  right_reverse(a,b);
+  return right_numerator();
+}
+
+//------------------------------------------------
+// MonoidTrait::right_reverse(const Word&,size_t)
+//------------------------------------------------
+
+Word
+MonoidTrait::right_reverse(const Word& w,size_t chunks){
+  if(chunks==0) chunks=thread_pool().size();
+  size_t l=w.size();
+  if(chunks>l/MIN_REVERSING_CHUNK) chunks=l/MIN_REVERSING_CHUNK;
+  if(chunks<2) return right_reverse(w);
+  //Each chunk is reversed into a fraction nums[i].dens[i]^-1
+  Array<Word> nums(chunks),dens(chunks);
+  parallel_for(chunks,[&](size_t i){
+    RightReversing* rr=right_engine();
+    rr->set_word(w.subword(i*l/chunks,(i+1)*l/chunks));
+    rr->full_reverse();
+    nums[i]=rr->numerator();
+    dens[i]=rr->denominator();
+  });
+  //Fractions N1.D1^-1 and N2.D2^-1 are merged by right reversing D1^-1.N2
+  //into X.Y^-1, their product being (N1.X).(D2.Y)^-1
+  for(size_t step=1;step<chunks;step*=2){
+    parallel_for((chunks+step-1)/(2*step),[&](size_t k){
+      size_t a=2*step*k;
+      size_t b=a+step;
+      RightReversing* rr=right_engine();
+      rr->set_word(dens[a],nums[b]);
+      rr->full_reverse();
+      nums[a]=nums[a].concatenate(rr->numerator());
+      dens[a]=dens[b].concatenate(rr->denominator());
+    });
+  }
+  return nums[0].concatenate(dens[0].inverse());
+}
+
+//------------------------------------------------
+// MonoidTrait::right_reverse(const Array<Word>&)
+//------------------------------------------------
+
+Array<Word>
+MonoidTrait::right_reverse(const Array<Word>& ws){
+  Array<Word> res(ws.size());
+  parallel_for(ws.size(),[&](size_t i){res[i]=right_reverse(ws[i]);});
+  return res;
+}
+
 //********
 //* Word *
 //********
@@ -587,7 +773,8 @@ MonoidTrait::right_gcd_x(const Word& a,const Word& b){
 // Word::Word(const initializer_list<Generator>&)
 //------------------------------------------------
 
-Word::Word(const initializer_list<Generator>& l):Array(l.size()){
+Word::Word(const initializer_list<Generator>& l):Array(nullptr,0){
+  reset(l.size());
   size_t i=0;
   for(auto it=l.begin();it!=l.end();++it){
     array[i++]=*it;
@@ -622,6 +809,46 @@ Word::display(DisplayGenerator d) const{
   return str;
 }
 
+//***************
+//* WordBuilder *
+//***************
+
+//------------------------------
+// WordBuilder::reserve(size_t)
+//------------------------------
+
+void
+WordBuilder::reserve(size_t n){
+  if(n<=capacity) return;
+  Generator* narray=new Generator[n];
+  if(array!=nullptr){
+    memcpy(narray,array,s*sizeof(Generator));
+    delete[] array;
+  }
+  array=narray;
+  capacity=n;
+}
+
+//---------------------
+// WordBuilder::word()
+//---------------------
+
+Word
+WordBuilder::word(){
+  if(s<=WORD_INLINE_SIZE){
+    Word res(s);
+    memcpy(res.array,array,s*sizeof(Generator));
+    s=0;
+    return res;
+  }
+  //The word takes over array
+  Array<Generator> a(array,s);
+  array=nullptr;
+  s=0;
+  capacity=0;
+  return Word(move(a));
+}
+
 //***********************
 //* Auxiliary functions *
 //***********************
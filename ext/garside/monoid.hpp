@@ -20,21 +20,38 @@
 #ifndef MONOID_HPP
 #define MONOID_HPP
 
+#include <atomic>
 #include <cstdint>
+#include <mutex>
+#include <vector>
 #include "../../array.hpp"
 #include "stacked_list.hpp"
+#include "thread_pool.hpp"
+#include "word_simd.hpp"
 
 #define MAX_COMPLEMENT_SIZE 64
+#define MAX_TABULATED_GENERATORS 256
+#define WORD_INLINE_SIZE 16
+#define MAX_LATTICE_RANK 8
+#define MIN_REVERSING_CHUNK 1024
+#define MAX_WORD_SIZE (size_t(1)<<28)
 
 //***************************
 //* Early class definitions *
 //***************************
 
+class ComplementTable;
+class ConjugacyEngine;
 class Reversing;
-class LeftReversing;
-class RightReversing;
+class LeftDirection;
+class RightDirection;
+template<class Direction> class DirectedReversing;
+template<class Direction,class Complement> class ReversingEngine;
 class PresentedMonoid;
+class SimpleLattice;
+class ThreadReversings;
 class Word;
+class WordBuilder;
 
 //************
 //* Typedefs *
@@ -54,11 +71,71 @@ typedef size_t(*GeneratorRank)(const Generator& x);
 typedef Generator(*RankedGeneratorBijection)(size_t r,const Generator& x,int p);
 //! Return a ranked word
 typedef Word(*RankedWordFactory)(size_t r);
+//! Return a ranked normal form of a word
+typedef Word(*RankedNormalForm)(size_t r,const Word& w);
+//! Return the normal form of a power of a ranked word
+typedef Word(*RankedPower)(size_t r,const Word& w,int64_t k);
+//! Return the i-th generator of a monoid family, generators being ordered by rank
+typedef Generator(*IndexedGenerator)(size_t i);
+//! Return the lattice of simple elements of a given rank
+typedef SimpleLattice*(*RankedLatticeFactory)(size_t r);
+//! Return a new conjugacy engine of a given rank
+typedef ConjugacyEngine*(*RankedConjugacyFactory)(size_t r);
+//! Test if two words represent the same element
+typedef bool(*WordProblem)(const Word& u,const Word& v);
+//! Interface of left reversing algorithm
+typedef DirectedReversing<LeftDirection> LeftReversing;
+//! Interface of right reversing algorithm
+typedef DirectedReversing<RightDirection> RightReversing;
   
 //********************* 
 //* Class definitions *
 //*********************
 
+//-----------------
+// ComplementTable
+//-----------------
+
+//! Dense table of complements between generators of bounded rank
+class ComplementTable{
+public:
+  //! Index marking a generator not covered by the table
+  static const uint16_t absent=0xFFFF;
+  //! Rank covered by the table
+  size_t rank;
+  //! Number of tabulated generators
+  size_t n;
+  //! Size of the index array, i.e., one plus the largest tabulated generator
+  size_t bound;
+  //! Dense index of a generator
+  uint16_t* index;
+  //! Offset of the complement of the k-th pair in letters
+  uint32_t* offsets;
+  //! Concatenated complements
+  Generator* letters;
+
+  //! Empty constructor
+  ComplementTable();
+
+  //! No copy constructor
+  ComplementTable(const ComplementTable&)=delete;
+
+  //! Destructor
+  ~ComplementTable();
+
+  //! No copy assignement
+  ComplementTable& operator=(const ComplementTable&)=delete;
+  
+  //! Test if the generator x is tabulated
+  bool contains(const Generator& x) const;
+  
+  //! Make c points to the complement of x and y and return its length
+  size_t get(const Generator& x,const Generator& y,const Generator*& c) const;
+
+  //! Tabulate complements given by sc of the n first generators given by ig
+  void init(size_t r,size_t n,SetComplement sc,IndexedGenerator ig);
+};
+
 //-----------
 // Reversing
 //-----------
@@ -74,13 +151,36 @@ public:
   Generator comp[MAX_COMPLEMENT_SIZE];
   //! Complement function
   SetComplement set_comp;
+  //! Tabulated complements, nullptr if not available
+  const ComplementTable* table;
+  //! Number of reversing steps since the last clear
+  size_t steps;
+  //! Number of letters removed by free reduction since the last clear
+  size_t reduced;
+  //! Workspace of free reduction
+  vector<Generator> reduction;
+  //! Free reduction of words given to set_word is enabled, the flag
+  //! being copied from the owner trait when the engine is handed out
+  bool free_reduction;
 
+  //! Destructor
+  virtual ~Reversing();
+  
   //! Clear internal word
   void clear();
 
+  //! Make c points to the complement of x and y and return its length
+  size_t complement(const Generator& x,const Generator& y,const Generator*& c);
+
   //! Display internal word
   void disp_word() const;
 
+  //! Set internal word to w where adjacent letters x.X if left is true, X.x
+  //! otherwise, are freely cancelled. These cancellations are the reversing
+  //! steps with empty complements, so the result of reversing is unchanged.
+  //! Return the size of the internal word.
+  size_t free_reduce(const Word& w,bool left);
+
   //! Return internal word
   Word get_word() const;
   
@@ -92,94 +192,186 @@ public:
 
   //! Set internal word
   void set_word(const Word& w);
+
+  //! Return the maximal subword of the internal word made of positive
+  //! letters if positive is true, of negative ones otherwise, which ends the
+  //! word if at_end is true and starts it otherwise. The inverse of the
+  //! subword is returned if invert is true.
+  Word sign_run(bool at_end,bool positive,bool invert) const;
+};
+
+//----------------------
+// Reversing directions
+//----------------------
+
+//! Direction of left reversing, which replaces x.Y by U.v. Fully reversed
+//! words are den^(-1).num, the denominator being on the left
+class LeftDirection{
+public:
+  static const bool left=true;
+
+  //! Test if the letters a.b form a reversible pattern x.Y
+  static bool reversible(const Generator& a,const Generator& b);
+};
+
+//! Direction of right reversing, which replaces X.y by u.V. Fully reversed
+//! words are num.den^(-1), the denominator being on the right
+class RightDirection{
+public:
+  static const bool left=false;
+
+  //! Test if the letters a.b form a reversible pattern X.y
+  static bool reversible(const Generator& a,const Generator& b);
 };
 
-//----------------
-// Left reversing
-//----------------
+//--------------------
+// Directed reversing
+//--------------------
 
-//! A class for left reversing algorithm
-class LeftReversing:public Reversing{  
+//! Interface of reversing algorithms in a given direction, which is
+//! LeftDirection or RightDirection
+template<class Direction>
+class DirectedReversing:public Reversing{
 public:
+  //! Reversing is left reversing
+  static const bool left=Direction::left;
+
   //! Unique constructor
-  LeftReversing(SetComplement sc);
-  
-  //! Test if full reversing gives a positive word when internal word is u.v^(-1)
-  bool check_positivity();
+  DirectedReversing(SetComplement sc);
 
-  //! Return numerator of the word
+  //! Test if full reversing gives a positive word when internal word is
+  //! u.v^(-1) for left reversing and u^(-1).v for right reversing
+  virtual bool check_positivity()=0;
+
+  //! Return a new engine of the same kind with an empty word
+  virtual DirectedReversing* clone() const=0;
+
+  //! Return denominator of the word
   Word denominator();
 
   //! Reverse untill the is no more reversing step
-  void full_reverse();
-  
+  virtual void full_reverse()=0;
+
   //! Return numerator of the word
   Word numerator();
 
   //! Perform one reversing step
-  void reverse();
+  virtual void reverse()=0;
 
   //! Set internal word to be w
   void set_word(const Word& w);
 
-  //! Set internal word to be num.den^(-1)
-  void set_word(const Word& num,const Word& den);
+  //! Set internal word to be u.v^(-1) for left reversing and u^(-1).v for
+  //! right reversing, that is num.den^(-1) and den^(-1).num
+  void set_word(const Word& u,const Word& v);
 };
 
-//-----------------
-// Right reversing
-//-----------------
+//-------------------
+// Complement policies
+//-------------------
+
+//! Complement given by the SetComplement function of the engine, tabulated
+//! complements being used when available
+class DynamicComplement{
+public:
+  static size_t get(Reversing& r,const Generator& x,const Generator& y,const Generator*& c);
+};
+
+//! Complement given at compile time, allowing it to be inlined
+template<SetComplement sc> class StaticComplement{
+public:
+  static size_t get(Reversing& r,const Generator& x,const Generator& y,const Generator*& c);
+};
 
-//! A class for right reversing
-class RightReversing:public Reversing{  
+//! Tabulated complement with a complement given at compile time as fallback
+template<SetComplement sc> class TabulatedComplement{
 public:
+  static size_t get(Reversing& r,const Generator& x,const Generator& y,const Generator*& c);
+};
+
+//------------------
+// Reversing engine
+//------------------
+
+//! Reversing algorithm specialised for a direction, which is LeftDirection
+//! or RightDirection, and a complement policy
+template<class Direction,class Complement>
+class ReversingEngine:public DirectedReversing<Direction>{
+public:
+  using DirectedReversing<Direction>::word;
+  using DirectedReversing<Direction>::to_reverse;
+  using DirectedReversing<Direction>::steps;
+  
   //! Unique constructor
-  RightReversing(SetComplement sc);
+  ReversingEngine(SetComplement sc);
 
-  //! Test if full reversing gives a positive word when internal word is u^(-1).v
+  //! Test if full reversing gives a positive word
   bool check_positivity();
-  
-  //! Return numerator of the word
-  Word denominator();
-  
-  //! Reverse untill the is no more reversing ste
+
+  //! Return a new engine of the same kind with an empty word
+  ReversingEngine* clone() const;
+
+  //! Reverse untill the is no more reversing step
   void full_reverse();
 
-  //! Return numerator of the word
-  Word numerator();
+  //! Insert the letters sign*c[0],...,sign*c[s-1] after node i, in reverse order
+  void insert_after(NInd i,const Generator* c,size_t s,int sign);
+  
+  //! Insert the letters sign*c[0],...,sign*c[s-1] before node i
+  void insert_before(NInd i,const Generator* c,size_t s,int sign);
 
-  //! Perform one reversing 
+  //! Perform one reversing step
   void reverse();
+};
 
-  //! Set internal word
-  void set_word(const Word& w);
+//------------------
+// ThreadReversings
+//------------------
+
+//! Reversing engines owned by a thread, indexed by MonoidTrait::engines_id
+class ThreadReversings{
+public:
+  //! Left reversing engines
+  vector<LeftReversing*> left;
+  //! Right reversing engines
+  vector<RightReversing*> right;
 
-  //! Set internal word to be den^(-1).num
-  void set_word(const Word& den,const Word& num);
+  //! Destructor
+  ~ThreadReversings();
 };
 
 //-------------
 // MonoidTrait
 //-------------
-//! Class for procedure attached to monoid
+//! Class for procedure attached to monoid. Reversing engines are cloned
+//! for each thread, so a trait can be used concurrently by several threads
 
 class MonoidTrait{
 public:
-  //! Pointer to a LeftReversing
+  //! Pointer to a LeftReversing, prototype of engines of threads
   LeftReversing* left_reversing;
-  //! Pointer to a RightReversing
+  //! Pointer to a RightReversing, prototype of engines of threads
   RightReversing* right_reversing;
+  //! Index of the engines of the trait in ThreadReversings
+  size_t engines_id;
+  //! Number of engines indices given so far
+  static atomic<size_t> engines_counter;
+  //! Free reduction is enabled for the engines of the trait
+  atomic<bool> free_reduction;
   //! Extra data
   void* data;
   //! Empty constructor
   MonoidTrait();
 
   //! Destructor
-  ~MonoidTrait();
+  virtual ~MonoidTrait();
 
   //! Test if two words are equivalent
   bool are_equivalent(const Word& u,const Word& v);
 
+  //! Test if u[i] and v[i] are equivalent for each i, in parallel
+  Array<bool> are_equivalent(const Array<Word>& u,const Array<Word>& v);
+
   //! Test if the family has a left complement
   bool has_left_complement() const;
    
@@ -202,6 +394,9 @@ public:
 
   //! Return left complement of x and y
   Word left_complement(const Generator& x,const Generator& y);
+
+  //! Return the left reversing engine of the calling thread
+  LeftReversing* left_engine();
   
   //! Return the left denominator
   Word left_denominator();
@@ -210,6 +405,9 @@ public:
   //! such that there exist x with a=c.x and y with b=c.y 
   Word left_gcd(const Word& a,const Word& b);
 
+  //! Return the left gcds of a[i] and b[i], computed in parallel
+  Array<Word> left_gcd(const Array<Word>& a,const Array<Word>& b);
+
   //! Return a Couple (c,d) where c is the left gcd of a and d is such that a=c.d
   pair<Word,Word> left_gcd_x(const Word& a,const Word& b);
   
@@ -217,6 +415,9 @@ public:
   //! such that there exist x with c=x.a and y with c=y.a
   Word left_lcm(const Word& a,const Word& b);
 
+  //! Return the left lcms of a[i] and b[i], computed in parallel
+  Array<Word> left_lcm(const Array<Word>& a,const Array<Word>& b);
+
   //! Return the left lcm complement of a and b, i.e.,
   //! an element d such that d.a is equal to the left lcm of a and b
   Word left_lcm_complement(const Word& a,const Word& b);
@@ -224,14 +425,32 @@ public:
   //! Return the left numerator
   Word left_numerator();
   
+  //! Return the number of letters removed by free reduction during the last
+  //! left reversing of the calling thread
+  size_t left_reduced_letters();
+  
+  //! Return the number of steps of the last left reversing of the calling thread
+  size_t left_reversing_steps();
+  
   //! Left reverse the word w
   Word left_reverse(const Word& w);
 
   //! Left reverse the u.v^(-1)
   Word left_reverse(const Word& u,const Word& v);
 
+  //! Left reverse the word w split into chunks, reversed in parallel and
+  //! then merged pairwise. The number of chunks is the number of threads
+  //! if 0 and is reduced so that chunks have at least MIN_REVERSING_CHUNK letters
+  Word left_reverse(const Word& w,size_t chunks);
+
+  //! Left reverse each word of ws in parallel
+  Array<Word> left_reverse(const Array<Word>& ws);
+
   //! Return right complement of x and y
   Word right_complement(const Generator& x,const Generator& y);
+
+  //! Return the right reversing engine of the calling thread
+  RightReversing* right_engine();
   
   //! Return the right denominator
   Word right_denominator();
@@ -240,12 +459,18 @@ public:
   //! such that there exist x with a=c.x and y with b=c.y
   Word right_gcd(const Word& a,const Word& b);
 
+  //! Return the right gcds of a[i] and b[i], computed in parallel
+  Array<Word> right_gcd(const Array<Word>& a,const Array<Word>& b);
+
   //!  Return a Couple (c,d) where c is the right gcd of a and d is such that a=d.c
   pair<Word,Word> right_gcd_x(const Word& a,const Word& b);
   
   //! Return the right lcm of a and b, i.e., a minimal element c
   //! such that there exist x with c=a.x and y with c=a.y 
   Word right_lcm(const Word& a,const Word& b);
+
+  //! Return the right lcms of a[i] and b[i], computed in parallel
+  Array<Word> right_lcm(const Array<Word>& a,const Array<Word>& b);
   
   //! Return the right lcm complement of a and b, i.e.,
   //! an element d such that a.d is equal to the right lcm of a and b 
@@ -254,17 +479,44 @@ public:
   //! Return right numerator
   Word right_numerator();
   
+  //! Return the number of letters removed by free reduction during the last
+  //! right reversing of the calling thread
+  size_t right_reduced_letters();
+  
+  //! Return the number of steps of the last right reversing of the calling thread
+  size_t right_reversing_steps();
+  
   //! Right reverse the word w
   Word right_reverse(const Word& w);
 
   //! Right reverse the u^(-1).v
   Word right_reverse(const Word& u,const Word& v);
+
+  //! Right reverse the word w split into chunks, reversed in parallel and
+  //! then merged pairwise. The number of chunks is the number of threads
+  //! if 0 and is reduced so that chunks have at least MIN_REVERSING_CHUNK letters
+  Word right_reverse(const Word& w,size_t chunks);
+
+  //! Right reverse each word of ws in parallel
+  Array<Word> right_reverse(const Array<Word>& ws);
+
+  //! Return a lattice of simple elements containing the letters of a and b,
+  //! used as a fast path when a and b are simple, or nullptr if there is none
+  virtual SimpleLattice* simple_lattice(const Word& a,const Word& b);
   
   //! Set left complement
   void set_left_complement(SetComplement sc);
 
   //! Set right complement
   void set_right_complement(SetComplement sc); 
+
+  //! Set left reversing engine, which is then owned by the trait.
+  //! Not thread safe
+  void set_left_reversing(LeftReversing* lr);
+
+  //! Set right reversing engine, which is then owned by the trait.
+  //! Not thread safe
+  void set_right_reversing(RightReversing* rr);
 };
 
 //--------------
@@ -286,6 +538,30 @@ public:
   RankedGeneratorBijection ranked_phi_germ;
   //! Ranked Garside element factory
   RankedWordFactory ranked_garside_word_factory;
+  //! Ranked Garside normal form
+  RankedNormalForm ranked_garside_normal_form;
+  //! Maximal rank supported by ranked_garside_normal_form
+  size_t garside_normal_form_rank;
+  //! Ranked power computed on normal forms, up to garside_normal_form_rank
+  RankedPower ranked_garside_power;
+  //! Ranked lattice of simple elements factory
+  RankedLatticeFactory ranked_lattice_factory;
+  //! Maximal rank supported by ranked_lattice_factory
+  size_t lattice_rank;
+  //! Lattices of simple elements built so far, indexed by rank
+  atomic<SimpleLattice*> lattices[MAX_LATTICE_RANK+1];
+  //! Mutex protecting the construction of lattices
+  mutex lattices_mutex;
+  //! Ranked conjugacy engine factory, used for ranks having no lattice
+  RankedConjugacyFactory ranked_conjugacy_factory;
+  //! Maximal rank supported by ranked_conjugacy_factory
+  size_t conjugacy_rank;
+  //! Enumeration of generators by rank
+  IndexedGenerator indexed_generator;
+  //! Tabulated left complements
+  ComplementTable left_table;
+  //! Tabulated right complements
+  ComplementTable right_table;
   
   //! Unique constructor
   MonoidFamily(string l,DisplayGenerator d,GeneratorsNumber n,GeneratorRank r);
@@ -295,12 +571,23 @@ public:
 
   //! Apply phi_r^p to the word
   void apply_phi(size_t r,Word& w,int p=1);
-  
+
+  //! Return a new conjugacy engine of rank r, working on the lattice of
+  //! simple elements if there is one and built by the ranked conjugacy
+  //! factory otherwise, or nullptr if there is none
+  ConjugacyEngine* conjugacy_engine(size_t r);
+
   //! Display
   string display() const;
     
   //! Return garside_element of rank r
   Word garside_element(size_t r);
+
+  //! Return the left-weighted Garside normal form of an element
+  Word garside_normal_form(const Word& w);
+
+  //! Return the left-weighted Garside normal form of an element of rank r
+  Word garside_normal_form(size_t r,const Word& w);
   
   //! Return number of generators for rank n
   size_t generators_number(size_t n);
@@ -310,6 +597,9 @@ public:
 
   //! Test if the family has a Garside element
   bool has_garside_element() const;
+
+  //! Test if the family has a Garside normal form
+  bool has_garside_normal_form() const;
   
   //! Return the word obtained under phi_r^p
   Word phi(size_t r,const Word& w,int p=1);
@@ -329,6 +619,15 @@ public:
   //! Return the ranked phi-splitting of an element
   Array<Word> phi_splitting(size_t r,const Word& w);
 
+  //! Return the k-th power of an element
+  Word power(const Word& w,int64_t k);
+
+  //! Return the k-th power of an element of rank r, in normal form if
+  //! the family has a ranked Garside power for this rank and as the raw
+  //! concatenation of k copies of w (or of its inverse) otherwise; an error
+  //! is raised if the result may exceed MAX_WORD_SIZE letters
+  Word power(size_t r,const Word& w,int64_t k);
+
   //! Return rank of a Word
   size_t rank(const Word& w);
 
@@ -336,19 +635,56 @@ public:
   void set_ranked_phi_germ(RankedGeneratorBijection rpg);
   
   //! Set ranked garside word factory
-  void set_ranked_garside_word_factory(RankedWordFactory rgwf);  
+  void set_ranked_garside_word_factory(RankedWordFactory rgwf);
+
+  //! Set ranked Garside normal form, available up to rank max_rank
+  void set_ranked_garside_normal_form(RankedNormalForm rgnf,size_t max_rank);
+
+  //! Set ranked Garside power, available up to garside_normal_form_rank
+  void set_ranked_garside_power(RankedPower rgp);
+
+  //! Set ranked conjugacy engine factory, used up to rank max_rank
+  void set_ranked_conjugacy_factory(RankedConjugacyFactory rcf,size_t max_rank);
+
+  //! Set ranked lattice of simple elements factory, used up to rank
+  //! max_rank which is at most MAX_LATTICE_RANK
+  void set_ranked_lattice_factory(RankedLatticeFactory rlf,size_t max_rank);
+
+  //! Return the lattice of simple elements of rank r, built on first use,
+  //! or nullptr if there is none
+  SimpleLattice* simple_lattice(size_t r);
+
+  //! Return the lattice of simple elements of the rank of a and b
+  SimpleLattice* simple_lattice(const Word& a,const Word& b);
+
+  //! Set enumeration of generators
+  void set_indexed_generator(IndexedGenerator ig);
+
+  //! Tabulate left and right complements of generators of rank <= r.
+  //! Not thread safe
+  void tabulate_complements(size_t r);
 };
 
 //------
 // Word
 //------
 
-//! Class for word 
+//! Class for word. Words of length at most WORD_INLINE_SIZE are stored
+//! in an internal buffer instead of the heap.
 class Word:public Array<Generator>{
 public:
+  //! Inline storage for short words
+  Generator buffer[WORD_INLINE_SIZE];
+  //! Cached fingerprint, 0 if not computed. It is kept by copies and
+  //! cleared by every accessor giving write access to the letters.
+  mutable uint64_t fingerprint;
+  
   //! Empty constructor
   Word();
 
+  //! Construct a word of length s with undefined letters
+  explicit Word(size_t s);
+  
   //! Construct a word from a list of Generator
   Word(const initializer_list<Generator>& l);
   
@@ -362,6 +698,9 @@ public:
   Word(const Array<Generator>&);
   Word(Array<Generator>&&);
 
+  //! Destructor
+  ~Word();
+
   //! Assignement operator with copy
   Word& operator=(const Word& w);
 
@@ -371,13 +710,89 @@ public:
   //! Concatenate a word to this one
   Word concatenate(const Word& w) const;
 
+  //! Return the i-th letter
+  const Generator& at(size_t i) const;
+
+  //! Return a reference to the i-th letter, clearing the fingerprint
+  Generator& at(size_t i);
+
   //! Return the word inverse of this one
   Word inverse() const;
 
   //! Display a word
   string display(DisplayGenerator d) const;
+
+  //! Test if letters are stored in the internal buffer
+  bool is_inline() const;
+
+  //! Return the i-th letter
+  const Generator& read(size_t i) const;
+
+  //! Set the length to n, letters being undefined
+  void reset(size_t n);
+
+  //! Return the subword made of letters of index in [i,j)
+  Word subword(size_t i,size_t j) const;
+
+  //! Set the i-th letter to x, clearing the fingerprint
+  void write(size_t i,const Generator& x);
+
+  //! Return the i-th letter
+  const Generator& operator[](size_t i) const;
+
+  //! Return a reference to the i-th letter, clearing the fingerprint
+  Generator& operator[](size_t i);
 };
 
+//-------------
+// WordBuilder
+//-------------
+
+//! Class for building a word by successive appends with amortised growth
+class WordBuilder{
+public:
+  //! Letters
+  Generator* array;
+  //! Number of letters
+  size_t s;
+  //! Allocated size of array
+  size_t capacity;
+
+  //! Construct an empty builder with room for c letters
+  WordBuilder(size_t c=WORD_INLINE_SIZE);
+
+  //! No copy constructor
+  WordBuilder(const WordBuilder&)=delete;
+
+  //! Destructor
+  ~WordBuilder();
+
+  //! No copy assignement
+  WordBuilder& operator=(const WordBuilder&)=delete;
+
+  //! Append a letter
+  void append(const Generator& x);
+  
+  //! Append a word
+  void append(const Word& w);
+
+  //! Ensure there is room for n letters
+  void reserve(size_t n);
+  
+  //! Return the number of letters
+  size_t size() const;
+  
+  //! Return the built word and empty the builder
+  Word word();
+};
+
+//******************
+//* Global objects *
+//******************
+
+//! Reversing engines of the calling thread
+extern thread_local ThreadReversings thread_reversings;
+
 //***********************
 //* Auxiliary functions *
 //***********************
@@ -403,13 +818,56 @@ Word operator*(const Word& u,const Word& v);
 //* Inline declarations *
 //***********************
 
+//-----------------
+// ComplementTable
+//-----------------
+
+inline
+ComplementTable::ComplementTable():rank(0),n(0),bound(0),index(nullptr),offsets(nullptr),letters(nullptr){
+}
+
+inline
+ComplementTable::~ComplementTable(){
+  if(index!=nullptr) delete[] index;
+  if(offsets!=nullptr) delete[] offsets;
+  if(letters!=nullptr) delete[] letters;
+}
+
+inline bool
+ComplementTable::contains(const Generator& x) const{
+  uint16_t ux=x;
+  return ux<bound and index[ux]!=absent;
+}
+
+inline size_t
+ComplementTable::get(const Generator& x,const Generator& y,const Generator*& c) const{
+  size_t k=index[x]*n+index[y];
+  c=letters+offsets[k];
+  return offsets[k+1]-offsets[k];
+}
+
 //-----------
 // Reversing
 //-----------
 
+inline
+Reversing::~Reversing(){
+}
+
 inline void
 Reversing::clear(){
   to_reverse.clear();
+  steps=0;
+  reduced=0;
+}
+
+inline size_t
+Reversing::complement(const Generator& x,const Generator& y,const Generator*& c){
+  if(table!=nullptr and table->contains(x) and table->contains(y)){
+    return table->get(x,y,c);
+  }
+  c=comp;
+  return set_comp(x,y,comp);
 }
 
 inline void
@@ -432,44 +890,224 @@ Reversing::set_word(const Word& w){
   word.init((NData*)w.array,w.size());
 }
 
-//----------------
-// Left reversing
-//----------------
+//----------------------
+// Reversing directions
+//----------------------
 
-inline
-LeftReversing::LeftReversing(SetComplement sc){
+inline bool
+LeftDirection::reversible(const Generator& a,const Generator& b){
+  return a>0 and b<0;
+}
+
+inline bool
+RightDirection::reversible(const Generator& a,const Generator& b){
+  return a<0 and b>0;
+}
+
+//--------------------
+// Directed reversing
+//--------------------
+
+template<class D> inline
+DirectedReversing<D>::DirectedReversing(SetComplement sc){
   set_comp=sc;
+  table=nullptr;
+  steps=0;
+  reduced=0;
+  free_reduction=true;
 }
 
-inline void
-LeftReversing::full_reverse(){
-  while(not to_reverse.empty())
-    reverse();
+template<class D> inline Word
+DirectedReversing<D>::denominator(){
+  return sign_run(not D::left,false,true);
 }
 
+template<class D> inline Word
+DirectedReversing<D>::numerator(){
+  return sign_run(D::left,true,false);
+}
 
-//-----------------
-// Right reversing
-//-----------------
+template<class D> void
+DirectedReversing<D>::set_word(const Word& w){
+  clear();
+  size_t s=free_reduce(w,D::left);
+  for(size_t i=1;i<s;++i){
+    if(D::reversible(word.nodes[i].data,word.nodes[i+1].data)){
+      to_reverse.push_back(i);
+    }
+  }
+}
 
-inline
-RightReversing::RightReversing(SetComplement sc){
-  set_comp=sc;
+template<class D> void
+DirectedReversing<D>::set_word(const Word& u,const Word& v){
+  clear();
+  size_t us=u.size();
+  size_t vs=v.size();
+  //Common suffixes of u and v give cancellations x.X around the junction
+  //of u.v^(-1), common prefixes give cancellations X.x in u^(-1).v
+  size_t k=0;
+  if(free_reduction){
+    while(k<us and k<vs){
+      Generator x=D::left?u[us-1-k]:u[k];
+      if(x<=0 or x!=(D::left?v[vs-1-k]:v[k])) break;
+      ++k;
+    }
+    us-=k;
+    vs-=k;
+    reduced+=2*k;
+  }
+  //Letters kept are u[o],...,u[o+us-1] and v[o],...,v[o+vs-1]
+  size_t o=D::left?0:k;
+  init_word(us+vs);
+  for(size_t i=0;i<us;++i){
+    word.nodes[i+1].data=D::left?u[i]:-u[o+us-1-i];
+  }
+  for(size_t i=0;i<vs;++i){
+    word.nodes[i+us+1].data=D::left?-v[vs-1-i]:v[o+i];
+  }
+  if(us*vs!=0) to_reverse.push_back(us);
 }
 
-inline void
-RightReversing::full_reverse(){
-  while(not to_reverse.empty()) reverse();
+//---------------------
+// Complement policies
+//---------------------
+
+inline size_t
+DynamicComplement::get(Reversing& r,const Generator& x,const Generator& y,const Generator*& c){
+  return r.complement(x,y,c);
+}
+
+template<SetComplement sc> inline size_t
+StaticComplement<sc>::get(Reversing& r,const Generator& x,const Generator& y,const Generator*& c){
+  c=r.comp;
+  return sc(x,y,r.comp);
+}
+
+template<SetComplement sc> inline size_t
+TabulatedComplement<sc>::get(Reversing& r,const Generator& x,const Generator& y,const Generator*& c){
+  const ComplementTable* table=r.table;
+  if(table!=nullptr and table->contains(x) and table->contains(y)){
+    return table->get(x,y,c);
+  }
+  c=r.comp;
+  return sc(x,y,r.comp);
+}
+
+//------------------
+// Reversing engine
+//------------------
+
+template<class D,class C> inline
+ReversingEngine<D,C>::ReversingEngine(SetComplement sc):DirectedReversing<D>(sc){
+}
+
+template<class D,class C> bool
+ReversingEngine<D,C>::check_positivity(){
+  while(not to_reverse.empty()){
+    ReversingEngine::reverse();
+    if(word.size>0 and (D::left?word.first():word.last())<0) return false;
+  }
+  return true;
+}
+
+template<class D,class C> ReversingEngine<D,C>*
+ReversingEngine<D,C>::clone() const{
+  ReversingEngine* res=new ReversingEngine(this->set_comp);
+  res->table=this->table;
+  return res;
+}
+
+template<class D,class C> void
+ReversingEngine<D,C>::full_reverse(){
+  while(not to_reverse.empty()) ReversingEngine::reverse();
+}
+
+template<class D,class C> inline void
+ReversingEngine<D,C>::insert_after(NInd i,const Generator* c,size_t s,int sign){
+  switch(s){
+  case 0:
+    return;
+  case 1:
+    word.insert_after(i,sign*c[0]);
+    return;
+  case 2:
+    word.insert_after(i,sign*c[0]);
+    word.insert_after(i,sign*c[1]);
+    return;
+  default:
+    for(size_t k=0;k<s;++k) word.insert_after(i,sign*c[k]);
+  }
+}
+
+template<class D,class C> inline void
+ReversingEngine<D,C>::insert_before(NInd i,const Generator* c,size_t s,int sign){
+  switch(s){
+  case 0:
+    return;
+  case 1:
+    word.insert_before(i,sign*c[0]);
+    return;
+  case 2:
+    word.insert_before(i,sign*c[0]);
+    word.insert_before(i,sign*c[1]);
+    return;
+  default:
+    for(size_t k=0;k<s;++k) word.insert_before(i,sign*c[k]);
+  }
+}
+
+template<class D,class C> inline void
+ReversingEngine<D,C>::reverse(){
+  //Left : replace ___x.Y___ by ___U.v___
+  //Right : replace ___X.y___ by ___u.V___
+  NInd i=to_reverse.back();
+  to_reverse.pop_back();
+  ++steps;
+  StackedListNode* nodes=word.nodes;
+  NInd j=nodes[i].next;
+  NInd p=nodes[i].previous;
+  NInd n=nodes[j].next;
+  Generator x,y;
+  if(D::left){
+    x=nodes[i].data;
+    y=-nodes[j].data;
+  }
+  else{
+    x=-nodes[i].data;
+    y=nodes[j].data;
+  }
+  //the word is __$.[i].[j].#__ with $=[p] and #=[n]
+  const Generator* c;
+  size_t s=C::get(*this,x,y,c);
+  if(D::left) insert_after(i,c,s,-1);
+  else insert_before(i,c,s,1);
+  word.erase(i);
+  s=C::get(*this,y,x,c);
+  if(D::left) insert_before(j,c,s,1);
+  else insert_after(j,c,s,-1);
+  word.erase(j);
+  //the word is now __$.[complements].#___ with $=[p] and #=[n]
+  nodes=word.nodes;
+  if(s>0){
+    if(D::reversible(nodes[p].data,nodes[nodes[p].next].data)){
+      to_reverse.push_back(p);
+    }
+    NInd m=nodes[n].previous;
+    if(D::reversible(nodes[m].data,nodes[n].data)){
+      to_reverse.push_back(m);
+    }
+  }
+  else{
+    if(D::reversible(nodes[p].data,nodes[n].data)){
+      to_reverse.push_back(p);
+    }
+  }
 }
 
 //--------------
 // MonoidFamily
 //--------------
 
-inline
-MonoidFamily::~MonoidFamily(){
-}
-
 inline string
 MonoidFamily::display() const{
   return label+" monoid family";
@@ -480,6 +1118,11 @@ MonoidFamily::garside_element(size_t r){
   return ranked_garside_word_factory(r);
 }
 
+inline Word
+MonoidFamily::garside_normal_form(const Word& w){
+  return garside_normal_form(rank(w),w);
+}
+
 inline size_t
 MonoidFamily::generators_number(size_t n){
   return gnum(n);
@@ -490,6 +1133,11 @@ MonoidFamily::has_garside_element() const{
   return ranked_garside_word_factory!=nullptr;
 }
 
+inline bool
+MonoidFamily::has_garside_normal_form() const{
+  return ranked_garside_normal_form!=nullptr;
+}
+
 inline bool
 MonoidFamily::has_garside_automorphism() const{
   return ranked_phi_germ!=nullptr;
@@ -500,6 +1148,11 @@ MonoidFamily::phi_normal(const Word& w){
   return phi_normal(rank(w),w);
 }
 
+inline Word
+MonoidFamily::power(const Word& w,int64_t k){
+  return power(rank(w),w,k);
+}
+
 				    
 inline void
 MonoidFamily::set_ranked_phi_germ(RankedGeneratorBijection rpg){
@@ -511,6 +1164,39 @@ MonoidFamily::set_ranked_garside_word_factory(RankedWordFactory rgwf){
   ranked_garside_word_factory=rgwf;
 }
 
+inline void
+MonoidFamily::set_ranked_garside_normal_form(RankedNormalForm rgnf,size_t max_rank){
+  ranked_garside_normal_form=rgnf;
+  garside_normal_form_rank=max_rank;
+}
+
+inline void
+MonoidFamily::set_ranked_garside_power(RankedPower rgp){
+  ranked_garside_power=rgp;
+}
+
+inline void
+MonoidFamily::set_ranked_conjugacy_factory(RankedConjugacyFactory rcf,size_t max_rank){
+  ranked_conjugacy_factory=rcf;
+  conjugacy_rank=max_rank;
+}
+
+inline void
+MonoidFamily::set_ranked_lattice_factory(RankedLatticeFactory rlf,size_t max_rank){
+  ranked_lattice_factory=rlf;
+  lattice_rank=min(max_rank,(size_t)MAX_LATTICE_RANK);
+}
+
+inline SimpleLattice*
+MonoidFamily::simple_lattice(const Word& a,const Word& b){
+  return simple_lattice(max(rank(a),rank(b)));
+}
+
+inline void
+MonoidFamily::set_indexed_generator(IndexedGenerator ig){
+  indexed_generator=ig;
+}
+
 //-------------
 // MonoidTrait
 //-------------
@@ -527,25 +1213,31 @@ MonoidTrait::has_right_complement() const{
 
 inline bool
 MonoidTrait::is_left_divisible(const Word& a,const Word& b){
-  right_reversing->set_word(b,a);
-  return right_reversing->check_positivity();
+  RightReversing* rr=right_engine();
+  rr->set_word(b,a);
+  return rr->check_positivity();
 }
 
 inline bool
 MonoidTrait::is_right_divisible(const Word& a,const Word& b){
-  left_reversing->set_word(a,b);
-  return left_reversing->check_positivity();
+  LeftReversing* lr=left_engine();
+  lr->set_word(a,b);
+  return lr->check_positivity();
 }
 
 inline Word
 MonoidTrait::left_denominator(){
-  return left_reversing->denominator();
+  return left_engine()->denominator();
 }
 
-inline Word
-MonoidTrait::left_lcm_complement(const Word& a,const Word& b){
-  left_reverse(b,a);
-  return left_numerator();
+inline LeftReversing*
+MonoidTrait::left_engine(){
+  vector<LeftReversing*>& engines=thread_reversings.left;
+  if(engines_id>=engines.size()) engines.resize(engines_id+1,nullptr);
+  LeftReversing*& lr=engines[engines_id];
+  if(lr==nullptr) lr=left_reversing->clone();
+  lr->free_reduction=free_reduction.load(memory_order_relaxed);
+  return lr;
 }
 
 inline Word
@@ -555,26 +1247,48 @@ MonoidTrait::left_lcm(const Word& a,const Word& b){
 
 inline Word
 MonoidTrait::left_numerator(){
-  return left_reversing->numerator();
+  return left_engine()->numerator();
+}
+
+inline size_t
+MonoidTrait::left_reduced_letters(){
+  return left_engine()->reduced;
+}
+
+inline size_t
+MonoidTrait::left_reversing_steps(){
+  return left_engine()->steps;
 }
 
 inline Word
 MonoidTrait::left_reverse(const Word& w){
-  left_reversing->set_word(w);
-  left_reversing->full_reverse();
-  return left_reversing->get_word();
+  LeftReversing* lr=left_engine();
+  lr->set_word(w);
+  lr->full_reverse();
+  return lr->get_word();
 }
 
 inline Word
 MonoidTrait::left_reverse(const Word& u,const Word& v){
-  left_reversing->set_word(u,v);
-  left_reversing->full_reverse();
-  return left_reversing->get_word();
+  LeftReversing* lr=left_engine();
+  lr->set_word(u,v);
+  lr->full_reverse();
+  return lr->get_word();
 }
 
 inline Word
 MonoidTrait::right_denominator(){
-  return right_reversing->denominator();
+  return right_engine()->denominator();
+}
+
+inline RightReversing*
+MonoidTrait::right_engine(){
+  vector<RightReversing*>& engines=thread_reversings.right;
+  if(engines_id>=engines.size()) engines.resize(engines_id+1,nullptr);
+  RightReversing*& rr=engines[engines_id];
+  if(rr==nullptr) rr=right_reversing->clone();
+  rr->free_reduction=free_reduction.load(memory_order_relaxed);
+  return rr;
 }
 
 inline Word
@@ -583,38 +1297,63 @@ MonoidTrait::right_lcm(const Word& a,const Word& b){
 }
 
 inline Word
-MonoidTrait::right_lcm_complement(const Word& a,const Word& b){
-  right_reverse(a,b);
-  return right_numerator();
+MonoidTrait::right_numerator(){
+  return right_engine()->numerator();
 }
 
-inline Word
-MonoidTrait::right_numerator(){
-  return right_reversing->numerator();
+inline size_t
+MonoidTrait::right_reduced_letters(){
+  return right_engine()->reduced;
+}
+
+inline size_t
+MonoidTrait::right_reversing_steps(){
+  return right_engine()->steps;
 }
 
 inline Word
 MonoidTrait::right_reverse(const Word& w){
-  right_reversing->set_word(w);
-  right_reversing->full_reverse();
-  return right_reversing->get_word();
+  RightReversing* rr=right_engine();
+  rr->set_word(w);
+  rr->full_reverse();
+  return rr->get_word();
 }
 
 inline Word
 MonoidTrait::right_reverse(const Word& u,const Word& v){
-  right_reversing->set_word(u,v);
-  right_reversing->full_reverse();
-  return right_reversing->get_word();
+  RightReversing* rr=right_engine();
+  rr->set_word(u,v);
+  rr->full_reverse();
+  return rr->get_word();
+}
+
+inline SimpleLattice*
+MonoidTrait::simple_lattice(const Word&,const Word&){
+  return nullptr;
 }
 
 inline void
 MonoidTrait::set_left_complement(SetComplement sc){
-  left_reversing=new LeftReversing(sc);
+  set_left_reversing(new ReversingEngine<LeftDirection,DynamicComplement>(sc));
+}
+
+inline void
+MonoidTrait::set_left_reversing(LeftReversing* lr){
+  if(left_reversing!=nullptr) delete left_reversing;
+  left_reversing=lr;
+  engines_id=engines_counter++;
 }
 
 inline void
 MonoidTrait::set_right_complement(SetComplement sc){
-  right_reversing=new RightReversing(sc);
+  set_right_reversing(new ReversingEngine<RightDirection,DynamicComplement>(sc));
+}
+
+inline void
+MonoidTrait::set_right_reversing(RightReversing* rr){
+  if(right_reversing!=nullptr) delete right_reversing;
+  right_reversing=rr;
+  engines_id=engines_counter++;
 }
 
 //------
@@ -622,33 +1361,190 @@ MonoidTrait::set_right_complement(SetComplement sc){
 //------
 
 inline
-Word::Word(){}
+Word::Word():Array(buffer,0){
+  fingerprint=0;
+}
+
+inline
+Word::Word(size_t n):Array(nullptr,0){
+  reset(n);
+}
+
+inline
+Word::Word(const Word& w):Array(nullptr,0){
+  reset(w.s);
+  memcpy(array,w.array,s*sizeof(Generator));
+  fingerprint=w.fingerprint;
+}
 
 inline
-Word::Word(const Word& w):Array(w){}
+Word::Word(Word&& w):Array(nullptr,0){
+  if(w.is_inline()){
+    array=buffer;
+    s=w.s;
+    memcpy(buffer,w.buffer,s*sizeof(Generator));
+  }
+  else{
+    array=w.array;
+    s=w.s;
+  }
+  fingerprint=w.fingerprint;
+  w.array=w.buffer;
+  w.s=0;
+  w.fingerprint=0;
+}
 
 inline
-Word::Word(Word&& w):Array(w){}
+Word::Word(const Array<Generator>& a):Array(nullptr,0){
+  reset(a.s);
+  memcpy(array,a.array,s*sizeof(Generator));
+}
 
 inline
-Word::Word(const Array<Generator>& a):Array(a){}
+Word::Word(Array<Generator>&& a):Array(nullptr,0){
+  if(a.s>WORD_INLINE_SIZE){
+    //Steal the heap storage of a
+    s=a.s;
+    array=a.array;
+    fingerprint=0;
+    a.s=0;
+    a.array=nullptr;
+  }
+  else{
+    reset(a.s);
+    memcpy(array,a.array,s*sizeof(Generator));
+  }
+}
 
 inline
-Word::Word(Array<Generator>&& a):Array(a){}
+Word::~Word(){
+  //Prevent ~Array to free the buffer
+  if(array==buffer) array=nullptr;
+}
+
+inline const Generator&
+Word::at(size_t i) const{
+  return Array::at(i);
+}
+
+inline Generator&
+Word::at(size_t i){
+  fingerprint=0;
+  return Array::at(i);
+}
 
 inline Word
 Word::concatenate(const Word& w) const{
   return Word(append(w));
 }
 
+inline bool
+Word::is_inline() const{
+  return array==buffer;
+}
+
+inline const Generator&
+Word::read(size_t i) const{
+  return Array::read(i);
+}
+
+inline Word
+Word::subword(size_t i,size_t j) const{
+  Word res(j-i);
+  memcpy(res.array,&array[i],(j-i)*sizeof(Generator));
+  return res;
+}
+
+inline void
+Word::write(size_t i,const Generator& x){
+  fingerprint=0;
+  Array::write(i,x);
+}
+
+inline const Generator&
+Word::operator[](size_t i) const{
+  return Array::operator[](i);
+}
+
+inline Generator&
+Word::operator[](size_t i){
+  fingerprint=0;
+  return Array::operator[](i);
+}
+
 inline Word&
 Word::operator=(const Word& w){
-  Array::operator=(w);
+  if(this!=&w){
+    reset(w.s);
+    memcpy(array,w.array,s*sizeof(Generator));
+    fingerprint=w.fingerprint;
+  }
+  return *this;
 }
 
 inline Word&
 Word::operator=(Word&& w){
-  Array::operator=(w);
+  if(this==&w) return *this;
+  if(w.is_inline()){
+    reset(w.s);
+    memcpy(array,w.buffer,s*sizeof(Generator));
+  }
+  else{
+    if(array!=buffer and array!=nullptr) delete[] array;
+    array=w.array;
+    s=w.s;
+  }
+  fingerprint=w.fingerprint;
+  w.array=w.buffer;
+  w.s=0;
+  w.fingerprint=0;
+  return *this;
+}
+
+inline void
+Word::reset(size_t n){
+  if(n<=WORD_INLINE_SIZE){
+    if(array!=buffer and array!=nullptr) delete[] array;
+    array=buffer;
+  }
+  else if(n!=s or array==buffer or array==nullptr){
+    if(array!=buffer and array!=nullptr) delete[] array;
+    array=new Generator[n];
+  }
+  s=n;
+  fingerprint=0;
+}
+
+//-------------
+// WordBuilder
+//-------------
+
+inline
+WordBuilder::WordBuilder(size_t c):array(new Generator[c]),s(0),capacity(c){
+}
+
+inline
+WordBuilder::~WordBuilder(){
+  if(array!=nullptr) delete[] array;
+}
+
+inline void
+WordBuilder::append(const Generator& x){
+  if(s==capacity) reserve(2*capacity+1);
+  array[s++]=x;
+}
+
+inline void
+WordBuilder::append(const Word& w){
+  size_t n=w.size();
+  if(s+n>capacity) reserve(max(2*capacity,s+n));
+  memcpy(array+s,w.array,n*sizeof(Generator));
+  s+=n;
+}
+
+inline size_t
+WordBuilder::size() const{
+  return s;
 }
 
 //***********************
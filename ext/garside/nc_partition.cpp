@@ -0,0 +1,149 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nc_partition.hpp"
+#include "braids.hpp"
+
+//***************
+//* NCPartition *
+//***************
+
+//--------------------------------------------
+// NCPartition::atom(size_t,const Generator&)
+//--------------------------------------------
+
+NCPartition
+NCPartition::atom(size_t n,const Generator& x){
+  NCPartition res(n);
+  size_t i=get_i(x)-1;
+  size_t j=get_j(x)-1;
+  res.set(i,j);
+  res.set(j,i);
+  return res;
+}
+
+//-------------------------------------
+// NCPartition::block_minima(uint64_t)
+//-----------------------------------
+
+uint64_t
+NCPartition::block_minima(uint64_t p){
+  //Pointer doubling : after t steps each point is labelled by the smallest
+  //of the 2^t first points of its cycle, which has at most 16 points
+#if defined(__SSSE3__)
+  //Nibbles are unpacked into bytes so that compositions are byte shuffles
+  __m128i v=_mm_cvtsi64_si128(p);
+  __m128i mask=_mm_set1_epi8(0x0F);
+  __m128i s=_mm_unpacklo_epi8(_mm_and_si128(v,mask),_mm_and_si128(_mm_srli_epi16(v,4),mask));
+  __m128i l=_mm_setr_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+  for(size_t t=0;t<4;++t){
+    l=_mm_min_epu8(l,_mm_shuffle_epi8(l,s));
+    s=_mm_shuffle_epi8(s,s);
+  }
+  //Bytes are packed back into nibbles
+  l=_mm_and_si128(_mm_or_si128(l,_mm_srli_epi16(l,4)),_mm_set1_epi16(0x00FF));
+  return _mm_cvtsi128_si64(_mm_packus_epi16(l,l));
+#else
+  uint64_t l=NC_PARTITION_IDENTITY;
+  for(size_t t=0;t<4;++t){
+    uint64_t nl=0,np=0;
+    for(size_t k=0;k<MAX_NC_PARTITION_SIZE;++k){
+      size_t i=(p>>(4*k))&0xF;
+      nl|=min((l>>(4*k))&0xF,(l>>(4*i))&0xF)<<(4*k);
+      np|=((p>>(4*i))&0xF)<<(4*k);
+    }
+    l=nl;
+    p=np;
+  }
+  return l;
+#endif
+}
+
+//-----------------------------------------------------
+// NCPartition::left_weight(NCPartition&,NCPartition&)
+//-----------------------------------------------------
+
+bool
+NCPartition::left_weight(NCPartition& a,NCPartition& b){
+  //Left and right divisors of a simple element coincide with the
+  //refinements of its partition, so the maximal c such that a.c is simple
+  //and c left divides b is the meet of d(a) and b.
+  NCPartition c=meet(a.right_complement(),b);
+  if(c.is_identity()) return false;
+  a=a*c;
+  b=c.inverse()*b;
+  return true;
+}
+
+//----------------------------------------------------------
+// NCPartition::meet(const NCPartition&,const NCPartition&)
+//----------------------------------------------------------
+
+NCPartition
+NCPartition::meet(const NCPartition& a,const NCPartition& b){
+  //Blocks of the meet are points sharing the smallest points of their
+  //blocks in a and in b, i.e., sharing both labels
+  uint64_t la=block_minima(a.packed);
+  uint64_t lb=block_minima(b.packed);
+  NCPartition res(a.n);
+  res.packed=0;
+  for(size_t k=0;k<MAX_NC_PARTITION_SIZE;++k){
+    //Nibbles of x are zero on the block of k in the meet
+    uint64_t x=(la^(((la>>(4*k))&0xF)*NC_PARTITION_ONES))|(lb^(((lb>>(4*k))&0xF)*NC_PARTITION_ONES));
+    uint64_t z=zero_nibbles(x);
+    //The block is closed into a decreasing cycle : k is sent to the
+    //previous point of its block, the smallest point to the largest one
+    uint64_t below=z&((uint64_t(1)<<(4*k))-1);
+    res.packed|=uint64_t((63-__builtin_clzll(below!=0?below:z))>>2)<<(4*k);
+  }
+  return res;
+}
+
+//---------------------
+// NCPartition::word()
+//---------------------
+
+Word
+NCPartition::word() const{
+  //The block b1<...<bk is the product a_(b1,b2)...a_(b(k-1),bk)
+  size_t l=0;
+  for(size_t k=0;k<n;++k){
+    if(get(k)<k) ++l;
+  }
+  Word res(l);
+  size_t ind=0;
+  uint32_t seen=0;
+  uint8_t block[MAX_NC_PARTITION_SIZE];
+  for(size_t k=0;k<n;++k){
+    if(seen>>k&1) continue;
+    //Following the cycle from its smallest point b1 we get b1,bk,...,b2
+    size_t s=0;
+    size_t p=k;
+    do{
+      seen|=uint32_t(1)<<p;
+      block[s++]=p;
+      p=get(p);
+    }while(p!=k);
+    for(size_t i=s-1;i>0;--i){
+      size_t u=(i==s-1)?block[0]:block[i+1];
+      res[ind++]=generator(u+1,block[i]+1);
+    }
+  }
+  return res;
+}
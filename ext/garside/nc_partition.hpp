@@ -0,0 +1,217 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NC_PARTITION_HPP
+#define NC_PARTITION_HPP
+
+#include <cstdint>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#include "monoid.hpp"
+
+//! Maximal number of points of a NCPartition
+#define MAX_NC_PARTITION_SIZE 16
+
+//! Packed identity, each point is its own image
+#define NC_PARTITION_IDENTITY 0xFEDCBA9876543210ULL
+
+//! Packed word whose nibbles are all equal to one
+#define NC_PARTITION_ONES 0x1111111111111111ULL
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Simple element of the dual braid monoid of type A on n points, encoded
+//! by its non-crossing partition. Each block b1<...<bk is stored as the
+//! cycle b1->bk->...->b2->b1 of the underlying permutation, whose images
+//! are packed in a 64 bits integer, 4 bits per point.
+class NCPartition{
+public:
+  //! Number of points
+  uint8_t n;
+
+  //! Packed images, unused points are fixed
+  uint64_t packed;
+
+  //! Construct the identity on n points
+  NCPartition(size_t n=0);
+
+  //! Return the simple element of the generator x on n points
+  static NCPartition atom(size_t n,const Generator& x);
+
+  //! Return the packed word whose k-th nibble is the smallest point of
+  //! the cycle of k in the packed permutation p
+  static uint64_t block_minima(uint64_t p);
+
+  //! Return the Garside element on n points
+  static NCPartition delta(size_t n);
+
+  //! Return the image of the point k
+  size_t get(size_t k) const;
+
+  //! Return the inverse permutation
+  NCPartition inverse() const;
+
+  //! Test if the element is trivial
+  bool is_identity() const;
+
+  //! Test if the element is the Garside element
+  bool is_delta() const;
+
+  //! Return the join of two simple elements, i.e., their lcm
+  static NCPartition join(const NCPartition& a,const NCPartition& b);
+
+  //! Make the pair (a,b) left-weighted without changing the product a*b
+  //! \return false if the pair was already left-weighted
+  static bool left_weight(NCPartition& a,NCPartition& b);
+
+  //! Return the meet of two simple elements, i.e., the common refinement
+  //! of their partitions, computed on packed words
+  static NCPartition meet(const NCPartition& a,const NCPartition& b);
+
+  //! Return the right complement s^-1*Delta of the simple element s
+  NCPartition right_complement() const;
+
+  //! Set the image of the point k to v
+  void set(size_t k,size_t v);
+
+  //! Return the image Delta^k*s*Delta^-k of the simple element s
+  NCPartition twist(int64_t k) const;
+
+  //! Return a positive word representing the simple element
+  Word word() const;
+
+  //! Return the packed word whose nibble k is 8 if the k-th nibble of x
+  //! is zero and 0 otherwise
+  static uint64_t zero_nibbles(uint64_t x);
+
+  //! Product of simple elements, the result must be simple
+  NCPartition operator*(const NCPartition& p) const;
+
+  //! Equality test
+  bool operator==(const NCPartition& p) const;
+
+  //! Total order, used for storing partitions in maps
+  bool operator<(const NCPartition& p) const;
+};
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//-------------
+// NCPartition
+//-------------
+
+inline
+NCPartition::NCPartition(size_t _n):n(_n),packed(NC_PARTITION_IDENTITY){}
+
+inline NCPartition
+NCPartition::delta(size_t n){
+  NCPartition res(n);
+  if(n==0) return res;
+  res.set(0,n-1);
+  for(size_t k=1;k<n;++k) res.set(k,k-1);
+  return res;
+}
+
+inline size_t
+NCPartition::get(size_t k) const{
+  return (packed>>(4*k))&0xF;
+}
+
+inline NCPartition
+NCPartition::inverse() const{
+  NCPartition res(n);
+  for(size_t k=0;k<n;++k) res.set(get(k),k);
+  return res;
+}
+
+inline bool
+NCPartition::is_identity() const{
+  return packed==NC_PARTITION_IDENTITY;
+}
+
+inline bool
+NCPartition::is_delta() const{
+  return *this==delta(n);
+}
+
+inline NCPartition
+NCPartition::join(const NCPartition& a,const NCPartition& b){
+  //Left and right divisibility coincide on simple elements, hence the
+  //right complement of the join is the meet of the right complements
+  return delta(a.n)*meet(a.right_complement(),b.right_complement()).inverse();
+}
+
+inline NCPartition
+NCPartition::right_complement() const{
+  //s^-1*Delta sends get(k) to k-1
+  NCPartition res(n);
+  if(n==0) return res;
+  res.set(get(0),n-1);
+  for(size_t k=1;k<n;++k) res.set(get(k),k-1);
+  return res;
+}
+
+inline void
+NCPartition::set(size_t k,size_t v){
+  packed=(packed&~(uint64_t(0xF)<<(4*k)))|(uint64_t(v)<<(4*k));
+}
+
+inline NCPartition
+NCPartition::twist(int64_t k) const{
+  //Conjugation by Delta rotates the points by one
+  int p=k%int64_t(n);
+  if(p<0) p+=n;
+  if(p==0) return *this;
+  NCPartition res(n);
+  for(size_t m=0;m<n;++m) res.set((m+p)%n,(get(m)+p)%n);
+  return res;
+}
+
+inline uint64_t
+NCPartition::zero_nibbles(uint64_t x){
+  //Adding 7 to the three low bits of a nibble sets its high bit unless
+  //they are zero, and no carry goes to the next nibble
+  const uint64_t low=0x7777777777777777ULL;
+  return ~(((x&low)+low)|x|low);
+}
+
+inline NCPartition
+NCPartition::operator*(const NCPartition& p) const{
+  NCPartition res(n);
+  for(size_t k=0;k<n;++k) res.set(k,p.get(get(k)));
+  return res;
+}
+
+inline bool
+NCPartition::operator==(const NCPartition& p) const{
+  return n==p.n and packed==p.packed;
+}
+
+inline bool
+NCPartition::operator<(const NCPartition& p) const{
+  if(n!=p.n) return n<p.n;
+  return packed<p.packed;
+}
+
+#endif
@@ -0,0 +1,356 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NORMAL_FORM_HPP
+#define NORMAL_FORM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include "../../module.hpp"
+#include "monoid.hpp"
+
+#define MAX_NORMAL_FORM_FACTORS (size_t(1)<<24)
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Left-weighted normal form Delta^k.s1...sm of a Garside group element.
+//! The class S of simple elements must provide
+//!  - S(n), S::delta(n) and S::atom(n,x) for the identity, Delta and a generator x>0
+//!  - is_identity(), is_delta(), right_complement(), twist(k) and word()
+//!  - S::left_weight(a,b) making (a,b) left-weighted, returning false if it was.
+template<class S> class NormalForm{
+public:
+  //! Size parameter of simple elements (number of strands for braids)
+  size_t n;
+
+  //! Power of Delta
+  int64_t delta_power;
+
+  //! Simple factors, none of them is Delta or trivial
+  deque<S> factors;
+
+  //! Construct the normal form of the identity
+  NormalForm(size_t n);
+
+  //! Set to the identity
+  void clear();
+
+  //! Return the inverse, whose normal form is obtained directly from the factors
+  NormalForm inverse() const;
+
+  //! Multiply on the left by a simple element
+  void left_multiply(const S& s);
+
+  //! Return the k-th power, computed by repeated squaring, raising an error
+  //! if it may have more than MAX_NORMAL_FORM_FACTORS simple factors
+  NormalForm power(int64_t k) const;
+
+  //! Return the word of the k-th power, raising an error before any
+  //! computation if it may exceed MAX_WORD_SIZE letters
+  Word power_word(int64_t k) const;
+
+  //! Multiply on the right by a simple element
+  void right_multiply(const S& s);
+
+  //! Set the size parameter to m, which must be at least n, without changing the element
+  void set_size(size_t m);
+
+  //! Set to the element represented by the word w
+  void set_word(const Word& w);
+
+  //! Return the word Delta^k.s1...sm, raising an error if it may exceed
+  //! MAX_WORD_SIZE letters
+  Word word() const;
+
+  //! Return an upper bound on the length of the word Delta^k.s1...sm
+  uint64_t word_size_bound() const;
+
+  //! Product of elements with the same size parameter
+  NormalForm operator*(const NormalForm& x) const;
+
+  //! Equality test
+  bool operator==(const NormalForm& x) const;
+
+  //! Total order on normal forms
+  bool operator<(const NormalForm& x) const;
+};
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Return p+q, raising an error if this Delta exponent does not fit
+int64_t add_delta_powers(int64_t p,int64_t q);
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//-----------------------------------
+// add_delta_powers(int64_t,int64_t)
+//-----------------------------------
+
+inline int64_t
+add_delta_powers(int64_t p,int64_t q){
+  int64_t res;
+  if(__builtin_add_overflow(p,q,&res)) RuntimeError("Power of Delta is too large");
+  return res;
+}
+
+//--------------------------------
+// NormalForm::NormalForm(size_t)
+//--------------------------------
+
+template<class S> inline
+NormalForm<S>::NormalForm(size_t _n):n(_n),delta_power(0){}
+
+//---------------------
+// NormalForm::clear()
+//---------------------
+
+template<class S> inline void
+NormalForm<S>::clear(){
+  delta_power=0;
+  factors.clear();
+}
+
+//-----------------------
+// NormalForm::inverse()
+//-----------------------
+
+template<class S> NormalForm<S>
+NormalForm<S>::inverse() const{
+  //As s^-1=d(s).Delta^-1, the inverse of Delta^p.s1...sm is
+  //Delta^-(p+m).t_m...t_1 with t_i=tau^(p+i)(d(s_i)), which is left-weighted
+  NormalForm res(n);
+  int64_t m=factors.size();
+  int64_t p=add_delta_powers(delta_power,m);
+  if(p==INT64_MIN) RuntimeError("Power of Delta is too large");
+  res.delta_power=-p;
+  for(int64_t i=m;i>0;--i){
+    res.factors.push_back(factors[i-1].right_complement().twist(delta_power+i));
+  }
+  return res;
+}
+
+//-------------------------------------
+// NormalForm::left_multiply(const S&)
+//-------------------------------------
+
+template<class S> void
+NormalForm<S>::left_multiply(const S& s){
+  //s.Delta^p=Delta^p.tau^-p(s), then the pairs are left-weighted from the
+  //left to the right until one of them is unchanged
+  S t=s.twist(-delta_power);
+  if(t.is_identity()) return;
+  factors.push_front(t);
+  for(size_t i=0;i+1<factors.size();++i){
+    if(not S::left_weight(factors[i],factors[i+1])) break;
+  }
+  if(not factors.empty() and factors.front().is_delta()){
+    factors.pop_front();
+    delta_power=add_delta_powers(delta_power,1);
+  }
+  while(not factors.empty() and factors.back().is_identity()){
+    factors.pop_back();
+  }
+}
+
+//----------------------------
+// NormalForm::power(int64_t)
+//----------------------------
+
+template<class S> NormalForm<S>
+NormalForm<S>::power(int64_t k) const{
+  uint64_t e=(k<0)?-(uint64_t)k:k;
+  if(not factors.empty() and e>MAX_NORMAL_FORM_FACTORS/factors.size()){
+    RuntimeError("Power is too large");
+  }
+  NormalForm res(n);
+  NormalForm x=(k<0)?inverse():*this;
+  while(e!=0){
+    if(e&1) res=res*x;
+    e>>=1;
+    if(e!=0) x=x*x;
+  }
+  return res;
+}
+
+//---------------------------------
+// NormalForm::power_word(int64_t)
+//---------------------------------
+
+template<class S> Word
+NormalForm<S>::power_word(int64_t k) const{
+  //The k-th power has at most |k| times as many simple factors, Delta
+  //included, as the element itself
+  uint64_t e=(k<0)?-(uint64_t)k:k;
+  uint64_t b=word_size_bound();
+  if(b!=0 and e>MAX_WORD_SIZE/b) RuntimeError("Power is too large");
+  return power(k).word();
+}
+
+//--------------------------------------
+// NormalForm::right_multiply(const S&)
+//--------------------------------------
+
+template<class S> void
+NormalForm<S>::right_multiply(const S& s){
+  if(s.is_identity()) return;
+  //Left-weight the pairs from the right to the left; once a pair is already
+  //left-weighted, the factors on its left are unchanged.
+  factors.push_back(s);
+  for(size_t i=factors.size()-1;i>0;--i){
+    if(not S::left_weight(factors[i-1],factors[i])) break;
+  }
+  while(not factors.empty() and factors.front().is_delta()){
+    factors.pop_front();
+    delta_power=add_delta_powers(delta_power,1);
+  }
+  while(not factors.empty() and factors.back().is_identity()){
+    factors.pop_back();
+  }
+}
+
+//------------------------------
+// NormalForm::set_size(size_t)
+//------------------------------
+
+template<class S> void
+NormalForm<S>::set_size(size_t m){
+  if(m==n) return;
+  Word w=word();
+  n=m;
+  set_word(w);
+}
+
+//-----------------------------------
+// NormalForm::set_word(const Word&)
+//-----------------------------------
+
+template<class S> void
+NormalForm<S>::set_word(const Word& w){
+  //We use x^-1=d(x).Delta^-1 and move every Delta^-1 to the left,
+  //a letter is then twisted by the number c of negative letters
+  //that are not on its left.
+  clear();
+  int c=0;
+  for(size_t i=0;i<w.size();++i){
+    if(w[i]<0) ++c;
+  }
+  int N=c;
+  for(size_t i=0;i<w.size();++i){
+    Generator x=w[i];
+    if(x>0) right_multiply(S::atom(n,x).twist(c));
+    else{
+      right_multiply(S::atom(n,-x).right_complement().twist(c));
+      --c;
+    }
+  }
+  delta_power=add_delta_powers(delta_power,-N);
+}
+
+//--------------------
+// NormalForm::word()
+//--------------------
+
+template<class S> Word
+NormalForm<S>::word() const{
+  if(word_size_bound()>MAX_WORD_SIZE) RuntimeError("Word is too large");
+  WordBuilder res;
+  if(delta_power!=0){
+    Word d=S::delta(n).word();
+    if(delta_power<0) d=d.inverse();
+    uint64_t e=(delta_power<0)?-(uint64_t)delta_power:delta_power;
+    for(uint64_t k=0;k<e;++k) res.append(d);
+  }
+  for(auto it=factors.begin();it!=factors.end();++it){
+    res.append(it->word());
+  }
+  return res.word();
+}
+
+//-------------------------------
+// NormalForm::word_size_bound()
+//-------------------------------
+
+template<class S> uint64_t
+NormalForm<S>::word_size_bound() const{
+  //Every simple factor is a prefix of Delta; the bound saturates
+  uint64_t e=(delta_power<0)?-(uint64_t)delta_power:delta_power;
+  uint64_t res;
+  if(__builtin_add_overflow(e,(uint64_t)factors.size(),&res) or
+     __builtin_mul_overflow(res,(uint64_t)S::delta(n).word().size(),&res)){
+    return UINT64_MAX;
+  }
+  return res;
+}
+
+//------------------------------------------
+// NormalForm::operator*(const NormalForm&)
+//------------------------------------------
+
+template<class S> NormalForm<S>
+NormalForm<S>::operator*(const NormalForm& x) const{
+  //The shortest normal form is multiplied into the longest one
+  if(factors.size()<=x.factors.size()){
+    NormalForm res(x);
+    for(auto it=factors.rbegin();it!=factors.rend();++it){
+      res.left_multiply(*it);
+    }
+    res.delta_power=add_delta_powers(res.delta_power,delta_power);
+    return res;
+  }
+  //Delta^p.A.Delta^q=Delta^(p+q).tau^q(A)
+  NormalForm res(*this);
+  for(auto it=res.factors.begin();it!=res.factors.end();++it){
+    *it=it->twist(-x.delta_power);
+  }
+  res.delta_power=add_delta_powers(res.delta_power,x.delta_power);
+  for(auto it=x.factors.begin();it!=x.factors.end();++it){
+    res.right_multiply(*it);
+  }
+  return res;
+}
+
+//-------------------------------------------
+// NormalForm::operator==(const NormalForm&)
+//-------------------------------------------
+
+template<class S> inline bool
+NormalForm<S>::operator==(const NormalForm& x) const{
+  return n==x.n and delta_power==x.delta_power and factors==x.factors;
+}
+
+//------------------------------------------
+// NormalForm::operator<(const NormalForm&)
+//------------------------------------------
+
+template<class S> bool
+NormalForm<S>::operator<(const NormalForm& x) const{
+  if(n!=x.n) return n<x.n;
+  if(delta_power!=x.delta_power) return delta_power<x.delta_power;
+  if(factors.size()!=x.factors.size()) return factors.size()<x.factors.size();
+  return lexicographical_compare(factors.begin(),factors.end(),x.factors.begin(),x.factors.end());
+}
+
+#endif
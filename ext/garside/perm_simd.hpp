@@ -0,0 +1,159 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERM_SIMD_HPP
+#define PERM_SIMD_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+//! Kernels on permutations of 32 points stored as 32 bytes, the image
+//! of k being p[k]. The implementation is chosen from the target given
+//! by -march : AVX2 (one 256 bits register), SSSE3 (two 128 bits
+//! registers) or a scalar fallback.
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PERM_SIMD "AVX2"
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define PERM_SIMD "SSSE3"
+#else
+#define PERM_SIMD "scalar"
+#endif
+
+//! Number of points of a permutation handled by the kernels
+#define PERM_SIMD_SIZE 32
+
+//*************************
+//* Function declarations *
+//*************************
+
+//! Set res to the permutation k -> b[a[k]]
+void perm_compose(const uint8_t* a,const uint8_t* b,uint8_t* res);
+
+//! Return the descent set of the n first entries of a,
+//! the bit i is set iff a[i]>a[i+1]
+uint32_t perm_descents(const uint8_t* a,size_t n);
+
+//! Set res to the inverse of the permutation a
+void perm_inverse(const uint8_t* a,uint8_t* res);
+
+//**********************
+//* Inline definitions *
+//**********************
+
+#if defined(__AVX2__)
+
+//------
+// AVX2
+//------
+
+inline void
+perm_compose(const uint8_t* a,const uint8_t* b,uint8_t* res){
+  //Byte shuffles do not cross 128 bits lanes, so we look up in both
+  //halves of b and select with the fifth bit of the indices
+  __m256i va=_mm256_loadu_si256((const __m256i*)a);
+  __m256i vb=_mm256_loadu_si256((const __m256i*)b);
+  __m256i lo=_mm256_permute2x128_si256(vb,vb,0x00);
+  __m256i hi=_mm256_permute2x128_si256(vb,vb,0x11);
+  __m256i sel=_mm256_slli_epi16(va,3);
+  __m256i r=_mm256_blendv_epi8(_mm256_shuffle_epi8(lo,va),_mm256_shuffle_epi8(hi,va),sel);
+  _mm256_storeu_si256((__m256i*)res,r);
+}
+
+inline uint32_t
+perm_descents(const uint8_t* a,size_t n){
+  //Successors of the entries : (a[1],...,a[31],0)
+  __m256i va=_mm256_loadu_si256((const __m256i*)a);
+  __m256i vs=_mm256_alignr_epi8(_mm256_permute2x128_si256(va,va,0x81),va,1);
+  uint32_t d=_mm256_movemask_epi8(_mm256_cmpgt_epi8(va,vs));
+  return (n<2)?0:d&((uint32_t(1)<<(n-1))-1);
+}
+
+#elif defined(__SSSE3__)
+
+//-------
+// SSSE3
+//-------
+
+inline __m128i
+perm_lookup(__m128i lo,__m128i hi,__m128i idx){
+  //Indices are less than 32, we select the half of the table with the fifth bit
+  __m128i sel=_mm_cmpgt_epi8(idx,_mm_set1_epi8(15));
+  __m128i rl=_mm_shuffle_epi8(lo,idx);
+  __m128i rh=_mm_shuffle_epi8(hi,idx);
+  return _mm_or_si128(_mm_andnot_si128(sel,rl),_mm_and_si128(sel,rh));
+}
+
+inline void
+perm_compose(const uint8_t* a,const uint8_t* b,uint8_t* res){
+  __m128i blo=_mm_loadu_si128((const __m128i*)b);
+  __m128i bhi=_mm_loadu_si128((const __m128i*)(b+16));
+  __m128i alo=_mm_loadu_si128((const __m128i*)a);
+  __m128i ahi=_mm_loadu_si128((const __m128i*)(a+16));
+  _mm_storeu_si128((__m128i*)res,perm_lookup(blo,bhi,alo));
+  _mm_storeu_si128((__m128i*)(res+16),perm_lookup(blo,bhi,ahi));
+}
+
+inline uint32_t
+perm_descents(const uint8_t* a,size_t n){
+  __m128i lo=_mm_loadu_si128((const __m128i*)a);
+  __m128i hi=_mm_loadu_si128((const __m128i*)(a+16));
+  //Successors of the entries : (a[1],...,a[16]) and (a[17],...,a[31],*)
+  __m128i slo=_mm_alignr_epi8(hi,lo,1);
+  __m128i shi=_mm_srli_si128(hi,1);
+  uint32_t d=_mm_movemask_epi8(_mm_cmpgt_epi8(lo,slo));
+  d|=uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(hi,shi)))<<16;
+  return (n<2)?0:d&((uint32_t(1)<<(n-1))-1);
+}
+
+#else
+
+//--------
+// Scalar
+//--------
+
+inline void
+perm_compose(const uint8_t* a,const uint8_t* b,uint8_t* res){
+  for(size_t k=0;k<PERM_SIMD_SIZE;++k) res[k]=b[a[k]];
+}
+
+inline uint32_t
+perm_descents(const uint8_t* a,size_t n){
+  uint32_t res=0;
+  for(size_t i=0;i+1<n;++i){
+    if(a[i]>a[i+1]) res|=(uint32_t(1)<<i);
+  }
+  return res;
+}
+
+#endif
+
+//---------------------------------------
+// perm_inverse(const uint8_t*,uint8_t*)
+//---------------------------------------
+
+inline void
+perm_inverse(const uint8_t* a,uint8_t* res){
+  //A scatter, which has no byte shuffle counterpart
+  for(size_t k=0;k<PERM_SIMD_SIZE;++k) res[a[k]]=k;
+}
+
+#endif
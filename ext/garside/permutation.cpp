@@ -0,0 +1,132 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "permutation.hpp"
+
+//***************
+//* Permutation *
+//***************
+
+//----------------------------------------------------------
+// Permutation::join(const Permutation&,const Permutation&)
+//----------------------------------------------------------
+
+Permutation
+Permutation::join(const Permutation& a,const Permutation& b){
+  //Crossings of the join are the transitive closure of those of a and b.
+  //The bit k of left[i] is set iff k>i and the strand k ends on the left
+  //of the strand i.
+  size_t n=a.n;
+  uint32_t left[MAX_PERMUTATION_SIZE];
+  for(size_t i=0;i<n;++i){
+    left[i]=0;
+    for(size_t k=i+1;k<n;++k){
+      if(a.image[i]>a.image[k] or b.image[i]>b.image[k]) left[i]|=uint32_t(1)<<k;
+    }
+  }
+  //Sets of strands k>i are already closed when the strand i is handled
+  for(size_t i=n;i>0;--i){
+    uint32_t l=left[i-1];
+    while(l!=0){
+      size_t k=__builtin_ctz(l);
+      l&=l-1;
+      left[i-1]|=left[k];
+    }
+  }
+  Permutation res(n);
+  for(size_t i=0;i<n;++i){
+    size_t p=__builtin_popcount(left[i]);
+    for(size_t k=0;k<i;++k){
+      if(not(left[k]>>i&1)) ++p;
+    }
+    res.image[i]=p;
+  }
+  return res;
+}
+
+//-----------------------------------------------------
+// Permutation::left_weight(Permutation&,Permutation&)
+//-----------------------------------------------------
+
+bool
+Permutation::left_weight(Permutation& a,Permutation& b){
+  //The pair (a,b) is left-weighted iff S(b) is included in F(a).
+  //While a letter x of S(b) is not in F(a) we replace (a,b) by (a.x,x^-1.b),
+  //both operations swap two adjacent entries and change the descent sets
+  //only around the swapped entries.
+  Permutation ai=a.inverse();
+  uint32_t F=ai.descents();
+  uint32_t S=b.descents();
+  uint32_t m=S&~F;
+  if(m==0) return false;
+  size_t last=b.n-1;
+  do{
+    size_t i=__builtin_ctz(m);
+    swap(ai.image[i],ai.image[i+1]);
+    swap(b.image[i],b.image[i+1]);
+    size_t first=(i==0)?0:i-1;
+    for(size_t j=first;j<=i+1 and j<last;++j){
+      uint32_t bit=uint32_t(1)<<j;
+      if(ai.image[j]>ai.image[j+1]) F|=bit;
+      else F&=~bit;
+      if(b.image[j]>b.image[j+1]) S|=bit;
+      else S&=~bit;
+    }
+    m=S&~F;
+  }while(m!=0);
+  a=ai.inverse();
+  return true;
+}
+
+//-----------------------
+// Permutation::length()
+//-----------------------
+
+size_t
+Permutation::length() const{
+  size_t res=0;
+  for(size_t i=0;i<n;++i){
+    for(size_t j=i+1;j<n;++j){
+      if(image[i]>image[j]) ++res;
+    }
+  }
+  return res;
+}
+
+//---------------------
+// Permutation::word()
+//---------------------
+
+Word
+Permutation::word() const{
+  //Repeatedly split a left divisor a_(i+1) off the braid
+  Word res(length());
+  Permutation p=*this;
+  size_t ind=0;
+  size_t i=0;
+  while(i+1<n){
+    if(p.image[i]>p.image[i+1]){
+      res[ind++]=i+1;
+      swap(p.image[i],p.image[i+1]);
+      if(i>0) --i;
+    }
+    else ++i;
+  }
+  return res;
+}
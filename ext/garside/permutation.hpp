@@ -0,0 +1,218 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERMUTATION_HPP
+#define PERMUTATION_HPP
+
+#include <cstdint>
+#include "monoid.hpp"
+#include "perm_simd.hpp"
+
+//! Maximal number of strands of a simple braid encoded by a Permutation
+#define MAX_PERMUTATION_SIZE PERM_SIMD_SIZE
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! Simple braid of Artin type A on n strands, encoded by its permutation.
+//! The strand starting at position k ends at position image[k]; as braids
+//! are read from left to right we have (a*b).image[k]=b.image[a.image[k]].
+class Permutation{
+public:
+  //! Number of strands
+  uint8_t n;
+
+  //! Images of 0,...,n-1, unused entries are fixed points
+  uint8_t image[MAX_PERMUTATION_SIZE];
+
+  //! Construct the identity on n strands
+  Permutation(size_t n=0);
+
+  //! Return the simple braid of the generator x on n strands
+  static Permutation atom(size_t n,const Generator& x);
+
+  //! Return the Garside element on n strands
+  static Permutation delta(size_t n);
+
+  //! Return the descent set of the permutation,
+  //! the bit i is set iff image[i]>image[i+1]
+  uint32_t descents() const;
+
+  //! Return the finishing set, the bit i is set iff s is right divisible by a_(i+1)
+  uint32_t finishing_set() const;
+
+  //! Return the inverse permutation
+  Permutation inverse() const;
+
+  //! Test if the braid is trivial
+  bool is_identity() const;
+
+  //! Test if the braid is the Garside element
+  bool is_delta() const;
+
+  //! Return the join of two simple braids for the left divisibility,
+  //! i.e., their right lcm
+  static Permutation join(const Permutation& a,const Permutation& b);
+
+  //! Make the pair (a,b) left-weighted without changing the product a*b
+  //! \return false if the pair was already left-weighted
+  static bool left_weight(Permutation& a,Permutation& b);
+
+  //! Return the number of crossings of the braid
+  size_t length() const;
+
+  //! Return the meet of two simple braids for the left divisibility,
+  //! i.e., their left gcd
+  static Permutation meet(const Permutation& a,const Permutation& b);
+
+  //! Return the right complement s^-1*Delta of the braid s
+  Permutation right_complement() const;
+
+  //! Return the starting set, the bit i is set iff s is left divisible by a_(i+1)
+  uint32_t starting_set() const;
+
+  //! Return the image Delta^k*s*Delta^-k of the braid s
+  Permutation twist(int64_t k) const;
+
+  //! Return a positive word representing the braid
+  Word word() const;
+
+  //! Product of braids
+  Permutation operator*(const Permutation& p) const;
+
+  //! Equality test
+  bool operator==(const Permutation& p) const;
+
+  //! Total order, used for storing permutations in maps
+  bool operator<(const Permutation& p) const;
+};
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//-------------
+// Permutation
+//-------------
+
+inline
+Permutation::Permutation(size_t _n):n(_n){
+  for(size_t k=0;k<MAX_PERMUTATION_SIZE;++k) image[k]=k;
+}
+
+inline Permutation
+Permutation::atom(size_t n,const Generator& x){
+  Permutation res(n);
+  res.image[x-1]=x;
+  res.image[x]=x-1;
+  return res;
+}
+
+inline Permutation
+Permutation::delta(size_t n){
+  Permutation res(n);
+  for(size_t k=0;k<n;++k) res.image[k]=n-1-k;
+  return res;
+}
+
+inline uint32_t
+Permutation::descents() const{
+  return perm_descents(image,n);
+}
+
+inline uint32_t
+Permutation::finishing_set() const{
+  return inverse().descents();
+}
+
+inline Permutation
+Permutation::inverse() const{
+  Permutation res(n);
+  perm_inverse(image,res.image);
+  return res;
+}
+
+inline bool
+Permutation::is_identity() const{
+  for(size_t k=0;k<n;++k){
+    if(image[k]!=k) return false;
+  }
+  return true;
+}
+
+inline bool
+Permutation::is_delta() const{
+  for(size_t k=0;k<n;++k){
+    if(image[k]!=n-1-k) return false;
+  }
+  return true;
+}
+
+inline Permutation
+Permutation::meet(const Permutation& a,const Permutation& b){
+  //s -> (s^-1.Delta)^-1 reverses the left divisibility, the reversed braid
+  //of a simple braid having the inverse permutation
+  Permutation ca=a.right_complement().inverse();
+  Permutation cb=b.right_complement().inverse();
+  return delta(a.n)*join(ca,cb);
+}
+
+inline Permutation
+Permutation::right_complement() const{
+  Permutation res(n);
+  perm_compose(inverse().image,delta(n).image,res.image);
+  return res;
+}
+
+inline uint32_t
+Permutation::starting_set() const{
+  return descents();
+}
+
+inline Permutation
+Permutation::twist(int64_t k) const{
+  //Conjugation by Delta is an involution
+  if(k%2==0) return *this;
+  Permutation d=delta(n);
+  Permutation res(n);
+  perm_compose(d.image,image,res.image);
+  perm_compose(res.image,d.image,res.image);
+  return res;
+}
+
+inline Permutation
+Permutation::operator*(const Permutation& p) const{
+  Permutation res(n);
+  perm_compose(image,p.image,res.image);
+  return res;
+}
+
+inline bool
+Permutation::operator==(const Permutation& p) const{
+  return n==p.n and memcmp(image,p.image,n)==0;
+}
+
+inline bool
+Permutation::operator<(const Permutation& p) const{
+  if(n!=p.n) return n<p.n;
+  return memcmp(image,p.image,n)<0;
+}
+
+#endif
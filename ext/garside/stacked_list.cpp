@@ -24,25 +24,16 @@
 //****************
 
 
-//--------------------------
-// StackedList::erase(NInd)
-//--------------------------
-
-void StackedList::erase(NInd i){
-  NInd p=nodes[i].previous;
-  NInd n=nodes[i].next;
-  nodes[p].next=n;
-  nodes[n].previous=p;
-  indices[size--]=i;
-}
-
 //----------------------------------
 // StackedList::fill(NData*,size_t)
 //----------------------------------
 
 void
 StackedList::fill(NData* array,size_t s){
+  reserve(s+1);
   size=s;
+  used=s+1;
+  nfree=0;
   nodes[0].data=0;
   nodes[0].previous=s;
   nodes[0].next=1;
@@ -54,6 +45,29 @@ StackedList::fill(NData* array,size_t s){
   nodes[s].next=0;
 }
 
+//---------------------------
+// StackedList::grow(size_t)
+//---------------------------
+
+void
+StackedList::grow(size_t n){
+  //Double the capacity, rounded to a multiple of STACKED_LIST_CHUNK
+  size_t c=2*capacity;
+  if(c<n) c=n;
+  c=((c+STACKED_LIST_CHUNK-1)/STACKED_LIST_CHUNK)*STACKED_LIST_CHUNK;
+  StackedListNode* nnodes=new StackedListNode[c];
+  NInd* nindices=new NInd[c];
+  if(nodes!=nullptr){
+    memcpy(nnodes,nodes,capacity*sizeof(StackedListNode));
+    memcpy(nindices,indices,capacity*sizeof(NInd));
+    delete[] nodes;
+    delete[] indices;
+  }
+  nodes=nnodes;
+  indices=nindices;
+  capacity=c;
+}
+
 //---------------------------
 // StackedList::init(size_t)
 //--------------------------
@@ -61,7 +75,9 @@ StackedList::fill(NData* array,size_t s){
 void
 StackedList::init(size_t s){
   clear();
+  reserve(s+1);
   size=s;
+  used=s+1;
   nodes[0].previous=s;
   nodes[0].next=1;
   for(size_t ind=0;ind<s;++ind){
@@ -72,40 +88,6 @@ StackedList::init(size_t s){
 }
 
 
-//----------------------------------------
-// StackedtList::insert_after(NInd,NData)
-//----------------------------------------
-
-NInd
-StackedList::insert_after(NInd i,NData data){
-  // p <-> i <-> n becomes p <-> i <-> j <-> n
-  NInd j=new_node();
-  NInd n=nodes[i].next;
-  nodes[j].previous=i;
-  nodes[j].next=n;
-  nodes[j].data=data;
-  nodes[i].next=j;
-  nodes[n].previous=j;
-  return j;
-}
-
-//----------------------------------------
-// StackedList::insert_before(NInd,Ndata)
-//----------------------------------------
-
-NInd
-StackedList::insert_before(NInd i,NData data){
-  //p <-> i <-> n becomes p <-> j <-> i <-> n
-  NInd j=new_node();
-  NInd p=nodes[i].previous;
-  nodes[j].previous=p;
-  nodes[j].next=i;
-  nodes[j].data=data;
-  nodes[i].previous=j;
-  nodes[p].next=j;
-  return j;
-}
-
 void
 StackedList::full_show() const{
   NInd ind=0;
@@ -124,10 +106,9 @@ StackedList::full_show() const{
 //***********************
 
 ostream& operator<<(ostream& os,const StackedList& list){
-  os<<" Stack =";
-  for(size_t i=0;i<=list.size;++i) os<<' '<<list.indices[i];
-  os<<'#';
-  for(size_t i=list.size+1;i<=20;++i) os<<' '<<list.indices[i];
+  os<<" Free =";
+  for(size_t i=0;i<list.nfree and i<20;++i) os<<' '<<list.indices[i];
+  os<<" # used = "<<list.used<<'/'<<list.capacity;
   os<<endl;
   if(list.is_empty()) return os<<"()";
   NInd ind=list.nodes[0].next;
@@ -25,12 +25,14 @@
 #include <deque>
 #include <stack>
 #include <cassert>
+#include <cstring>
 
 using namespace std;
 
-#define SIZE 1024
+//! Number of nodes added to a StackedList each time it grows
+#define STACKED_LIST_CHUNK 1024
 
-typedef uint16_t NInd;
+typedef uint32_t NInd;
 typedef int16_t NData;
 
 
@@ -58,16 +60,31 @@ private:
   //\return index of the new created node
   NInd new_node();
 
+  //! Grow the node arena so that it contains at least n nodes
+  void grow(size_t n);
+
+  //! Ensure that the node arena contains at least n nodes
+  void reserve(size_t n);
+
 public:
   //! Size of the stacked list 0 for empty
   //! Attention, there is exactly size+1 nodes used in the list
   size_t size;
+
+  //! Number of allocated nodes
+  size_t capacity;
+
+  //! Number of nodes taken from the arena since the last clear (node 0 included)
+  size_t used;
+
+  //! Number of released nodes stored in indices
+  size_t nfree;
   
   //! An array of Node used or not in the list
-  StackedListNode nodes[SIZE];
+  StackedListNode* nodes;
 
-  //! Indices of all available nodes
-  NInd indices[SIZE];
+  //! Indices of released nodes, reused before taking new nodes in the arena
+  NInd* indices;
 
   //! The empty constructor
   StackedList();
@@ -75,7 +92,16 @@ public:
   //! Construct a StackedList from an array of size s
   StackedList(NData* array,size_t s);
 
-  //! Clear the current StackedList
+  //! A StackedList is not copyable
+  StackedList(const StackedList&)=delete;
+
+  //! Destructor
+  ~StackedList();
+
+  //! A StackedList is not copyable
+  StackedList& operator=(const StackedList&)=delete;
+
+  //! Clear the current StackedList in constant time
   void clear();
   
   //! Erase the node i in the list
@@ -131,27 +157,44 @@ StackedListNode::StackedListNode(){}
 //-------------
 
 inline
-StackedList::StackedList(){
+StackedList::StackedList():capacity(0),nodes(nullptr),indices(nullptr){
+  grow(STACKED_LIST_CHUNK);
   clear();
   nodes[0].data=0;
-  nodes[0].previous=0;
-  nodes[0].next=0;
 }
 
 inline
-StackedList::StackedList(NData* array,size_t s){
+StackedList::StackedList(NData* array,size_t s):capacity(0),nodes(nullptr),indices(nullptr){
+  grow(STACKED_LIST_CHUNK);
   clear();
   fill(array,s);
 }
 
+inline
+StackedList::~StackedList(){
+  if(nodes!=nullptr) delete[] nodes;
+  if(indices!=nullptr) delete[] indices;
+}
+
 inline void
 StackedList::clear(){
   size=0;
-  for(size_t i=0;i<SIZE;++i) indices[i]=i;
+  used=1;
+  nfree=0;
   nodes[0].previous=0;
   nodes[0].next=0;
 }
 
+inline void
+StackedList::erase(NInd i){
+  NInd p=nodes[i].previous;
+  NInd n=nodes[i].next;
+  nodes[p].next=n;
+  nodes[n].previous=p;
+  indices[nfree++]=i;
+  --size;
+}
+
 inline void
 StackedList::init(NData* array,size_t s){
   clear();
@@ -163,6 +206,32 @@ StackedList::is_empty() const{
   return size==0;
 }
 
+inline NInd
+StackedList::insert_after(NInd i,NData data){
+  // p <-> i <-> n becomes p <-> i <-> j <-> n
+  NInd j=new_node();
+  NInd n=nodes[i].next;
+  nodes[j].previous=i;
+  nodes[j].next=n;
+  nodes[j].data=data;
+  nodes[i].next=j;
+  nodes[n].previous=j;
+  return j;
+}
+
+inline NInd
+StackedList::insert_before(NInd i,NData data){
+  //p <-> i <-> n becomes p <-> j <-> i <-> n
+  NInd j=new_node();
+  NInd p=nodes[i].previous;
+  nodes[j].previous=p;
+  nodes[j].next=i;
+  nodes[j].data=data;
+  nodes[i].previous=j;
+  nodes[p].next=j;
+  return j;
+}
+
 inline NData
 StackedList::first(){
   return nodes[nodes[0].next].data;
@@ -175,7 +244,15 @@ StackedList::last(){
 
 inline NInd
 StackedList::new_node(){
-  return indices[++size];
+  ++size;
+  if(nfree>0) return indices[--nfree];
+  if(used==capacity) grow(used+1);
+  return used++;
+}
+
+inline void
+StackedList::reserve(size_t n){
+  if(n>capacity) grow(n);
 }
 
 
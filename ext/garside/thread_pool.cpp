@@ -0,0 +1,243 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "thread_pool.hpp"
+
+//******************
+//* Global objects *
+//******************
+
+//! Set for threads executing a job of a pool
+static thread_local bool in_thread_pool=false;
+
+//*********************
+//* Local definitions *
+//*********************
+
+//! Set in_thread_pool during its lifetime, even if an exception is thrown
+class InThreadPool{
+public:
+  InThreadPool(){in_thread_pool=true;}
+  ~InThreadPool(){in_thread_pool=false;}
+};
+
+//**************
+//* ThreadPool *
+//**************
+
+//----------------------------------
+// ThreadPool::ThreadPool(size_t n)
+//----------------------------------
+
+ThreadPool::ThreadPool(size_t n):generation(0),finished(0),stop(false),job(nullptr),grain(1),remaining(0),available(0),cancelled(false){
+  if(n==0) n=thread::hardware_concurrency();
+  if(n==0) n=1;
+  nthreads=n;
+  queues=new Queue[n];
+  for(size_t id=1;id<n;++id){
+    threads.push_back(thread(&ThreadPool::work,this,id));
+  }
+}
+
+//---------------------------
+// ThreadPool::~ThreadPool()
+//---------------------------
+
+ThreadPool::~ThreadPool(){
+  {
+    lock_guard<mutex> lock(m);
+    stop=true;
+  }
+  cv_start.notify_all();
+  for(size_t i=0;i<threads.size();++i) threads[i].join();
+  delete[] queues;
+}
+
+//-----------------------------------------------------------------------
+// ThreadPool::parallel_for(size_t,const function<void(size_t)>&,size_t)
+//-----------------------------------------------------------------------
+
+void
+ThreadPool::parallel_for(size_t n,const function<void(size_t)>& f,size_t g){
+  if(n==0) return;
+  if(nthreads==1 or n==1 or in_thread_pool){
+    for(size_t i=0;i<n;++i) f(i);
+    return;
+  }
+  lock_guard<mutex> job_lock(job_mutex);
+  {
+    lock_guard<mutex> lock(m);
+    job=&f;
+    grain=(g==0)?n/(8*nthreads)+1:g;
+    remaining=n;
+    finished=0;
+    cancelled=false;
+    error=nullptr;
+    //No thread waits for a range yet, so push() and its notification
+    //are not needed
+    queues[0].ranges.push_back(Range{0,n});
+    available=1;
+    ++generation;
+  }
+  cv_start.notify_all();
+  {
+    InThreadPool scope;
+    run(0);
+  }
+  unique_lock<mutex> lock(m);
+  cv_done.wait(lock,[this]{return finished==nthreads-1;});
+  job=nullptr;
+  if(error!=nullptr){
+    exception_ptr e=error;
+    error=nullptr;
+    lock.unlock();
+    rethrow_exception(e);
+  }
+}
+
+//--------------------------------
+// ThreadPool::pop(size_t,Range&)
+//--------------------------------
+
+bool
+ThreadPool::pop(size_t id,Range& r){
+  Queue& q=queues[id];
+  lock_guard<mutex> lock(q.m);
+  if(q.ranges.empty()) return false;
+  r=q.ranges.back();
+  q.ranges.pop_back();
+  --available;
+  return true;
+}
+
+//---------------------------------------
+// ThreadPool::push(size_t,const Range&)
+//---------------------------------------
+
+void
+ThreadPool::push(size_t id,const Range& r){
+  Queue& q=queues[id];
+  {
+    lock_guard<mutex> lock(q.m);
+    q.ranges.push_back(r);
+    ++available;
+  }
+  //Taking m orders the notification after the check of a waiting thread
+  {
+    lock_guard<mutex> lock(m);
+  }
+  cv_range.notify_one();
+}
+
+//-------------------------
+// ThreadPool::run(size_t)
+//-------------------------
+
+void
+ThreadPool::run(size_t id){
+  Range r;
+  while(true){
+    if(not pop(id,r) and not steal(id,r)){
+      unique_lock<mutex> lock(m);
+      if(remaining==0) return;
+      cv_range.wait(lock,[this]{return remaining==0 or available>0;});
+      continue;
+    }
+    //A cancelled job only counts its ranges down
+    if(not cancelled){
+      //Keep the lower half and expose the upper one to thieves
+      while(r.last-r.first>grain){
+        size_t middle=(r.first+r.last)/2;
+        push(id,Range{middle,r.last});
+        r.last=middle;
+      }
+      try{
+        for(size_t i=r.first;i<r.last;++i) (*job)(i);
+      }
+      catch(...){
+        lock_guard<mutex> lock(m);
+        if(error==nullptr) error=current_exception();
+        cancelled=true;
+      }
+    }
+    if((remaining-=r.last-r.first)==0){
+      {
+        lock_guard<mutex> lock(m);
+      }
+      cv_range.notify_all();
+    }
+  }
+}
+
+//----------------------------------
+// ThreadPool::steal(size_t,Range&)
+//----------------------------------
+
+bool
+ThreadPool::steal(size_t id,Range& r){
+  for(size_t k=1;k<nthreads;++k){
+    Queue& q=queues[(id+k)%nthreads];
+    lock_guard<mutex> lock(q.m);
+    if(not q.ranges.empty()){
+      r=q.ranges.front();
+      q.ranges.pop_front();
+      --available;
+      return true;
+    }
+  }
+  return false;
+}
+
+//--------------------------
+// ThreadPool::work(size_t)
+//--------------------------
+
+void
+ThreadPool::work(size_t id){
+  in_thread_pool=true;
+  size_t seen=0;
+  while(true){
+    {
+      unique_lock<mutex> lock(m);
+      cv_start.wait(lock,[this,seen]{return stop or generation!=seen;});
+      if(stop) return;
+      seen=generation;
+    }
+    run(id);
+    {
+      lock_guard<mutex> lock(m);
+      ++finished;
+    }
+    cv_done.notify_all();
+  }
+}
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//---------------
+// thread_pool()
+//---------------
+
+ThreadPool&
+thread_pool(){
+  static ThreadPool pool;
+  return pool;
+}
@@ -0,0 +1,164 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//**********************
+//* Class declarations *
+//**********************
+
+//! A pool of threads sharing loops by work stealing. Each thread owns a
+//! deque of index ranges : it splits the range at its back until reaching
+//! the grain size and, when its deque is empty, steals the range at the
+//! front of the deque of another thread. The first exception thrown by
+//! the job cancels the remaining indices and is rethrown to the caller.
+class ThreadPool{
+private:
+  //! Range [first,last) of indices
+  class Range{
+  public:
+    size_t first,last;
+  };
+
+  //! Ranges owned by a thread
+  class Queue{
+  public:
+    mutex m;
+    deque<Range> ranges;
+  };
+
+  //! Number of threads, the caller of parallel_for included
+  size_t nthreads;
+  //! Queues of threads, the one of the caller being the first
+  Queue* queues;
+  //! Worker threads
+  vector<thread> threads;
+  //! Serialise calls to parallel_for
+  mutex job_mutex;
+  //! Protect job dispatch
+  mutex m;
+  //! Signal a new job to workers
+  condition_variable cv_start;
+  //! Signal the end of a worker job
+  condition_variable cv_done;
+  //! Signal a new range or the end of the current job to idle threads
+  condition_variable cv_range;
+  //! Number of dispatched jobs
+  size_t generation;
+  //! Number of workers done with the current job
+  size_t finished;
+  //! Set to stop workers
+  bool stop;
+  //! Current job
+  const function<void(size_t)>* job;
+  //! Maximal size of a range executed without splitting
+  size_t grain;
+  //! Number of indices of the current job not yet processed
+  atomic<size_t> remaining;
+  //! Number of ranges in the queues
+  atomic<size_t> available;
+  //! Set once the current job has thrown, its remaining ranges are skipped
+  atomic<bool> cancelled;
+  //! First exception thrown by the current job
+  exception_ptr error;
+
+  //! Pop a range from the back of the id-th queue
+  bool pop(size_t id,Range& r);
+
+  //! Push a range at the back of the id-th queue
+  void push(size_t id,const Range& r);
+
+  //! Process the current job as the id-th thread
+  void run(size_t id);
+
+  //! Steal a range at the front of a queue other than the id-th one
+  bool steal(size_t id,Range& r);
+
+  //! Loop of the id-th worker thread
+  void work(size_t id);
+public:
+  //! Construct a pool of n threads, the hardware concurrency if n is 0
+  ThreadPool(size_t n=0);
+
+  //! No copy constructor
+  ThreadPool(const ThreadPool&)=delete;
+
+  //! Destructor
+  ~ThreadPool();
+
+  //! No copy assignement
+  ThreadPool& operator=(const ThreadPool&)=delete;
+
+  //! Apply f to every index of [0,n) and wait for completion. A call from
+  //! a thread of the pool is executed sequentially. If f throws, the
+  //! indices not yet started are skipped and the first exception is
+  //! rethrown once every thread is done.
+  //! \param g grain, i.e., maximal number of indices processed as a whole,
+  //! chosen automatically if 0
+  void parallel_for(size_t n,const function<void(size_t)>& f,size_t g=0);
+
+  //! Return the number of threads
+  size_t size() const;
+};
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+//! Return the global pool of threads
+ThreadPool& thread_pool();
+
+//! Apply f to every index of [0,n) using the global pool of threads
+void parallel_for(size_t n,const function<void(size_t)>& f);
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//------------
+// ThreadPool
+//------------
+
+inline size_t
+ThreadPool::size() const{
+  return nthreads;
+}
+
+//***********************
+//* Auxiliary functions *
+//***********************
+
+inline void
+parallel_for(size_t n,const function<void(size_t)>& f){
+  thread_pool().parallel_for(n,f);
+}
+
+#endif
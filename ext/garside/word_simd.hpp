@@ -0,0 +1,84 @@
+/**
+ * This file is part of Gomu.
+ *
+ *  Copyright 2016 by Jean Fromentin <jean.fromentin@math.cnrs.fr>
+ *
+ * Gomu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Gomu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Gomu. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORD_SIMD_HPP
+#define WORD_SIMD_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+//! Kernels on words stored as arrays of 16 bits signed letters. The
+//! implementation is chosen from the target given by -march : AVX2 (16
+//! letters per step), SSE2 (8 letters per step) or a scalar fallback.
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WORD_SIMD "AVX2"
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define WORD_SIMD "SSE2"
+#else
+#define WORD_SIMD "scalar"
+#endif
+
+//*************************
+//* Function declarations *
+//*************************
+
+//! Return the least index i>=first such that w[i]+w[i+1]=0, i.e., such
+//! that w[i].w[i+1] is x.X or X.x, and s if there is none
+size_t word_find_cancellation(const int16_t* w,size_t first,size_t s);
+
+//**********************
+//* Inline definitions *
+//**********************
+
+//------------------------------------------------------
+// word_find_cancellation(const int16_t*,size_t,size_t)
+//------------------------------------------------------
+
+inline size_t
+word_find_cancellation(const int16_t* w,size_t first,size_t s){
+  size_t i=first;
+#if defined(__AVX2__)
+  //Compare letters w[i..i+15] with their successors w[i+1..i+16]
+  for(;i+17<=s;i+=16){
+    __m256i a=_mm256_loadu_si256((const __m256i*)(w+i));
+    __m256i b=_mm256_loadu_si256((const __m256i*)(w+i+1));
+    __m256i z=_mm256_cmpeq_epi16(_mm256_add_epi16(a,b),_mm256_setzero_si256());
+    uint32_t m=_mm256_movemask_epi8(z);
+    if(m!=0) return i+__builtin_ctz(m)/2;
+  }
+#elif defined(__SSE2__)
+  //Compare letters w[i..i+7] with their successors w[i+1..i+8]
+  for(;i+9<=s;i+=8){
+    __m128i a=_mm_loadu_si128((const __m128i*)(w+i));
+    __m128i b=_mm_loadu_si128((const __m128i*)(w+i+1));
+    __m128i z=_mm_cmpeq_epi16(_mm_add_epi16(a,b),_mm_setzero_si128());
+    uint32_t m=_mm_movemask_epi8(z);
+    if(m!=0) return i+__builtin_ctz(m)/2;
+  }
+#endif
+  for(;i+1<s;++i){
+    if(w[i]+w[i+1]==0) return i;
+  }
+  return s;
+}
+
+#endif
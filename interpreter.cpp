@@ -40,6 +40,9 @@ namespace Gomu{
   Type *type_tuple=new Type("Tuple",tuple_disp,tuple_del,tuple_copy,tuple_comp);
   Type *type_type=new Type("Type",type_disp,type_del,type_copy,type_comp);
   Type *type_void=new Type("Void",void_disp,void_del,void_copy,void_comp);
+
+  char boolean_false=0;
+  char boolean_true=1;
   
   //***********************
   //* Context definitions *
@@ -91,6 +94,7 @@ namespace Gomu{
 	ContextError("A locked symbol named "+fullname+" already exists");
       MetaFunction* meta_function=(MetaFunction*)symbol->ptr;
       meta_function->functions.insert(fullname);
+      meta_function->clear_cache();
       Function* function=new Function(tr,signature,ptr);
       add_symbol(fullname,type_function,function,true);
       return;      
@@ -136,6 +140,7 @@ namespace Gomu{
     s.ptr=ptr;s.locked=lock;
     s.name=name;
     s.hide=false;
+    table.symbols[table.intern(name)]=&s;
     return &s;
   }
 
@@ -165,37 +170,33 @@ namespace Gomu{
   }
 
  
-  //-----------------------------------------
-  // Context::eval_array(size_t,Node&,Node*)
-  //-----------------------------------------
+  //-------------------------------------
+  // Context::eval_array(Value**,size_t)
+  //-------------------------------------
   
-  void 
-  Context::eval_array(size_t size,Node& current, Node* nodes){
+  Value
+  Context::eval_array(Value** args,size_t size){
     ArrayValue* array;
     if(size==0) array=new ArrayValue(0);
     else{
-      size_t j=current.son;
       int k=0;
-      Type* type=nodes[j].value.eval()->type;
+      Type* type=args[0]->eval()->type;
       if(type==nullptr or type==type_void)
 	ContextError("Non empty Array of undefinded type is forbidden");
       array=new ArrayValue(size);
       array->type=type;
-      while(j!=-1){
-	Node* node=&nodes[j];
-	Value* val=node->value.eval();
+      for(size_t j=0;j<size;++j){
+	Value* val=args[j]->eval();
 	//Test if the type is correct
 	if(val->type!=type){
 	  //No -> delete array
 	  for(int i=0;i<k;++i) type->del(array->tab[i]);
 	  delete[] array->tab;
 	  delete array;
-	  current.value.ptr=nullptr;
-	  current.value.type=type_void;
 	  ContextError("Elements of an Array must have same type");
 	}
 	//We cannot stole pointer of value for a symbol
-	if(node->value.type==type_symbol){
+	if(args[j]->type==type_symbol){
 	  array->tab[k++]=type->copy(val->ptr);
 	}
 	else{
@@ -203,11 +204,9 @@ namespace Gomu{
 	  val->type=type_void;
 	  val->ptr=nullptr;
 	}
-	j=node->bro;
       }
     }
-    current.value.ptr=array;
-    current.value.type=type_array; 
+    return Value(type_array,array);
   }
 
   //-----------------------------------------------------------------------
@@ -251,19 +250,16 @@ namespace Gomu{
     return function->eval(args,nargs);
   }
 
-  //-------------------------------------
-  // Context::eval_function(Node&,Node*)
-  //-------------------------------------
+  //-----------------------------------------------
+  // Context::eval_function(size_t,Value**,size_t)
+  //-----------------------------------------------
   
-  void
-  Context::eval_function(Node& current,Node* nodes){
-    string name=current.str;
-    Symbol* symbol=get_symbol(name);
+  Value
+  Context::eval_function(size_t id,Value** args,size_t nargs){
+    Symbol* symbol=get_symbol(id);
     if(symbol==nullptr)
-      ContextError("There is no symbol named "+name);
-    Value* args[max_arguments_number];
-    size_t nargs=set_arguments(current,nodes,args);
-    current.value=eval_function(symbol,args,nargs);
+      ContextError("There is no symbol named "+table.names[id]);
+    return eval_function(symbol,args,nargs);
   }
 
   //------------------------------------------------
@@ -284,99 +280,87 @@ namespace Gomu{
 	  args[i]=(Value*)(args[i]->ptr);
 	}
       }
-      string fullname=function_fullname(symbol->name,args,nargs);
-      Value *val=get_symbol(fullname);
-      if(val==nullptr) ContextError("There is no function "+fullname);
-      if(val->type!=type_function) Bug("This case shall be impossible!");
-      return eval_function((Function*)val->ptr,args,nargs);
+      //Resolution by fullname is only done for argument types not in the cache
+      MetaFunction* meta_function=(MetaFunction*)symbol->ptr;
+      Function* function=meta_function->find_in_cache(args,nargs);
+      if(function==nullptr){
+	string fullname=function_fullname(symbol->name,args,nargs);
+	Value *val=get_symbol(fullname);
+	if(val==nullptr) ContextError("There is no function "+fullname);
+	if(val->type!=type_function) Bug("This case shall be impossible!");
+	function=(Function*)val->ptr;
+	meta_function->add_to_cache(args,nargs,function);
+      }
+      return eval_function(function,args,nargs);
     }
     else{
       Bug("The symbol named "+symbol->name+" is not callable");
     }
   }
 
-  //--------------------------------------------
-  // Context::eval_member_function(Node&,Node*)
-  //--------------------------------------------
+  //------------------------------------------------------
+  // Context::eval_member_function(size_t,Value**,size_t)
+  //------------------------------------------------------
   
-  void
-  Context::eval_member_function(Node& current,Node* nodes){
-    string name=current.str;
-    Value* args[max_arguments_number];
-    size_t nargs=set_arguments(current,nodes,args);
+  Value
+  Context::eval_member_function(size_t id,Value** args,size_t nargs){
     Value* first=args[0]->eval();
     Type* type=first->type;
-    Symbol* symbol=get_symbol(type,name);
+    Symbol* symbol=get_symbol(type,id);
     if(symbol==nullptr){
       if(type==type_type){
 	type=(Type*)first->ptr;
-	symbol=get_symbol(type,name);
+	symbol=get_symbol(type,id);
 	//current.son=nodes[current.son].bro;
 	if(symbol==nullptr)
-	  ContextError("No member function "+name+" for tyipe "+type->name);
-	current.value=eval_function(symbol,&args[1],nargs-1);
-	return;
+	  ContextError("No member function "+table.names[id]+" for tyipe "+type->name);
+	return eval_function(symbol,&args[1],nargs-1);
       }
       else{
-	ContextError("No member function "+name+" for type "+type->name);
+	ContextError("No member function "+table.names[id]+" for type "+type->name);
       }
     }
-    current.value=eval_function(symbol,args,nargs);
+    return eval_function(symbol,args,nargs);
   }
 
-  //--------------------------------------------------------
-  // Context::eval_member_symbol(Node& current,Node* nodes)
-  //--------------------------------------------------------
+  //---------------------------------------------
+  // Context::eval_member_symbol(Symbol*,size_t)
+  //---------------------------------------------
 
-  void
-  Context::eval_member_symbol(Node& current,Node* nodes){
-    string name=current.str;
-    Node& cnode=nodes[current.son];
-    Symbol* symbol=get_symbol(cnode.str);
-    if(symbol==nullptr) ContextError("Class type unkown");
+  Value
+  Context::eval_member_symbol(Symbol* symbol,size_t id){
     Type* type=symbol->type;
-    if(type==type_type){
-      name=cnode.str+"."+name;
-    }
-    else{
-      name=type->name+"."+name;
-    }
-    symbol=get_symbol(name);
-    if(symbol==nullptr) ContextError("Symbol "+name+" does not exist");
-    current.value.type=type_symbol;
-    current.value.ptr=symbol;
+    if(type==type_type) type=(Type*)symbol->ptr;
+    Symbol* member=get_symbol(type,id);
+    if(member==nullptr) ContextError("Symbol "+type->name+"."+table.names[id]+" does not exist");
+    return Value(type_symbol,member);
   }
 
-  //---------------------------------------
-  // Context::eval_set(size_t,Node&,Node*)
-  //---------------------------------------
+  //-----------------------------------
+  // Context::eval_set(Value**,size_t)
+  //-----------------------------------
   
-  void 
-  Context::eval_set(size_t size,Node& current, Node* nodes){
+  Value
+  Context::eval_set(Value** args,size_t size){
     SetValue* set;
     if(size==0) set=new SetValue(type_generic);
     else{
-      size_t j=current.son;
-      int k=0;
-      Type* type=nodes[j].value.eval()->type;
+      Type* type=args[0]->eval()->type;
       if(type==nullptr or type==type_void)
 	ContextError("Non empty Set of undefinded type is forbidden");
       set=new SetValue(type);
-      while(j!=-1){
-	Node* node=&nodes[j];
-	Value* val=node->value.eval();
+      for(size_t j=0;j<size;++j){
+	Value* val=args[j]->eval();
 	//Test if the type is correct
 	if(val->type!=type){
 	  //No -> delete set
 	  for(auto it=set->data.begin();it!=set->data.end();++it) type->del(*it);
 	  delete set;
-	  current.value.ptr=nullptr;
-	  current.value.type=type_void;
 	  ContextError("Elements of a Set must have same type");
 	}
 	//Check if the value is not in the set otherwise do nothing
 	if(set->data.find(val->ptr)==set->data.end()){
-	  if(node->value.type==type_symbol){
+	  if(args[j]->type==type_symbol){
 	    //We cannot stole pointer of value for a symbol
 	    set->data.insert(type->copy(val->ptr));
 	  }
@@ -386,42 +370,35 @@ namespace Gomu{
 	    val->ptr=nullptr;
 	  }
 	}
-	j=node->bro;
       }
     }
-    current.value.ptr=set;
-    current.value.type=type_set;
+    return Value(type_set,set);
   }
 
-  //-----------------------------------------
-  // Context::eval_tuple(size_t,Node&,Node*)
-  //-----------------------------------------
+  //-------------------------------------
+  // Context::eval_tuple(Value**,size_t)
+  //-------------------------------------
 
-  void 
-  Context::eval_tuple(size_t size,Node& current, Node* nodes){
+  Value
+  Context::eval_tuple(Value** args,size_t size){
     TupleValue* tuple;
     if(size==0) tuple=new TupleValue(0);
     else{
-      size_t j=current.son;
-      int k=0;
       tuple=new TupleValue(size);
-      while(j!=-1){
-	Node* node=&nodes[j];
-	Value* val=node->value.eval();
+      for(size_t k=0;k<size;++k){
+	Value* val=args[k]->eval();
 	//We cannot stole pointer of value for a symbol
-	if(node->value.type==type_symbol){
-	  tuple->tab[k++]=val->copy();
+	if(args[k]->type==type_symbol){
+	  tuple->tab[k]=val->copy();
 	}
 	else{
-	  tuple->tab[k++]=*val;
+	  tuple->tab[k]=*val;
 	  val->type=type_void;
 	  val->ptr=nullptr;
 	}
-	j=node->bro;
       }
     }
-    current.value.ptr=tuple;
-    current.value.type=type_tuple;
+    return Value(type_tuple,tuple);
   }
 
   //-------------------------------------
@@ -436,15 +413,20 @@ namespace Gomu{
     return s;
   }
 
-  //---------------------------
-  // Context::get_symbol(name)
-  //---------------------------
+  //-----------------------------------
+  // Context::get_symbol(Type*,size_t)
+  //-----------------------------------
   
   Symbol*
-  Context::get_symbol(string name){
-    auto it=symbols.find(name);
-    if(it==symbols.end()) return nullptr;
-    return &it->second;
+  Context::get_symbol(Type* ctype,size_t id){
+    vector<Symbol*>& table_members=members[ctype];
+    if(id<table_members.size() and table_members[id]!=nullptr) return table_members[id];
+    //The name type.name is only built at the first lookup of a member
+    size_t fid=table.find(ctype->name,table.names[id]);
+    if(fid==SymbolTable::npos or table.symbols[fid]==nullptr) return nullptr;
+    if(id>=table_members.size()) table_members.resize(table.names.size(),nullptr);
+    table_members[id]=table.symbols[fid];
+    return table_members[id];
   }
 
   //-------------------------
@@ -596,6 +578,7 @@ namespace Gomu{
     if(symbol->type!=type_meta_function) Bug("The symbol "+name+" is not of type Function or MetaFunction");
     MetaFunction* meta=(MetaFunction*)(symbol->ptr);
     meta->functions.erase(fullname);
+    meta->clear_cache();
     if(meta->functions.empty()) //There is no more function called name
       unload_symbol(name);
   }
@@ -641,15 +624,33 @@ namespace Gomu{
     }
   }
 
+  //--------------------------------
+  // Context::unload_symbol(string)
+  //--------------------------------
+
+  void
+  Context::unload_symbol(string name){
+    auto it=symbols.find(name);
+    if(it==symbols.end()) return;
+    table.symbols[table.find(name)]=nullptr;
+    //Member tables may point to the symbol
+    members.clear();
+    symbols.erase(it);
+  }
+
   //-----------------------------
   // Context::unload_type(Type*)
   //-----------------------------
   
   void
   Context::unload_type(Type* type){
-    for(auto it=symbols.begin();it!=symbols.end();++it){
+    for(auto it=symbols.begin();it!=symbols.end();){
+      //The symbol is erased by unload_symbol
+      auto next=it;
+      ++next;
       if(it->second.type==type)
 	unload_symbol(it->first);
+      it=next;
     }
     unload_symbol(type->name);
   }
@@ -764,21 +765,6 @@ namespace Gomu{
     load_module_symbols(module);
   }
 
-  //---------------------------------------------
-  // Context::set_arguments(Node&,Node*,Value**)
-  //---------------------------------------------
-  
-  size_t
-  Context::set_arguments(Node& current,Node* nodes,Value** args){
-    size_t j=current.son;
-    size_t nargs=0;
-    while(j!=-1){
-      args[nargs++]=&nodes[j].value;
-      j=nodes[j].bro;
-    }
-    return nargs;
-  }
-
   //**********************
   //* ContextualFunction *
   //**********************
@@ -862,6 +848,16 @@ namespace Gomu{
   //* Interpreter *
   //***************
 
+  //-----------------------------
+  // Interpreter::~Interpreter()
+  //-----------------------------
+
+  Interpreter::~Interpreter(){
+    for(auto it=programs.begin();it!=programs.end();++it){
+      delete it->second;
+    }
+  }
+
   //-------------------------------------------------------------------------
   // Interperter::add_operator(const string&,const string&,OperatorType,int)
   //-------------------------------------------------------------------------
@@ -929,6 +925,49 @@ namespace Gomu{
     return "";
   }
 
+  //---------------------------------------
+  // Interpreter::compile(size_t,Program&)
+  //---------------------------------------
+
+  size_t
+  Interpreter::compile(size_t pos,Program& program){
+    Node& node=nodes[pos];
+    vector<size_t> args;
+    if(node.expressionType==expLeaf){
+      if(node.tokenType==tName){
+	return program.add_instruction(insSymbol,program.add_name(node.str),args);
+      }
+      //The literal value is moved from the node to the program
+      program.constants.push_back(node.value);
+      node.value.ptr=nullptr;
+      return program.add_instruction(insConstant,program.constants.size()-1,args);
+    }
+    slong j=node.son;
+    while(j!=-1){
+      args.push_back(compile(j,program));
+      j=nodes[j].bro;
+    }
+    switch(node.expressionType){
+    case expFunction:
+    case expMemberFunction:
+      if(args.size()>max_arguments_number)
+	SyntaxError("Too many arguments",node.pos,node.pos+node.str.length()-1);
+      return program.add_instruction((node.expressionType==expFunction)?insFunction:insMemberFunction,program.add_name(node.str),args);
+    case expMemberSymbol:
+      return program.add_instruction(insMemberSymbol,program.add_name(node.str),args);
+    case expArray:
+      return program.add_instruction(insArray,0,args);
+    case expSet:
+      return program.add_instruction(insSet,0,args);
+    case expTuple:
+      return program.add_instruction(insTuple,0,args);
+    case expArrayGet:
+      Bug("Exp array get not yet implemented");
+    default:
+      Bug("Not yet implemented");
+    }
+  }
+
   //-------------------------------------------------
   // Interpreter::construct_sequence(size_t&,size_t)
   //-------------------------------------------------
@@ -1252,81 +1291,24 @@ namespace Gomu{
   //------------------------------------------------------
 
   Value* Interpreter::eval_basic(string cmd,Context& context){
-    size_t root;
-    Node* node;
-    bool error=false;
-    split_to_tokens(cmd);
-    size_t first=0;
-    root=construct_tree(first,nodes_number-1,max_precedence_level);
-    eval_expression(root,context);
-    node=&nodes[root];
-    return &node->value;
-  }
-  
-  //-----------------------------------------------
-  // Interpreter::eval_expression(size_t,Context&)
-  //-----------------------------------------------
-  
-  void Interpreter::eval_expression(size_t pos,Context& context){
-    Node &node=nodes[pos];
-    if(node.expressionType==expLeaf){
-      if(node.tokenType==tName){
-	node.value.type=type_symbol;
-	Symbol* symbol=context.get_symbol(node.str);
-	if(symbol!=nullptr){
-	  node.value.ptr=symbol;
-	}
-	else{
-	  node.value.ptr=context.add_symbol(node.str,type_void,nullptr,false);
-	}
-	return;
-      }
-      return;
-    }
-    size_t size=0;
-    slong j=node.son;
-    while(j!=-1){
-      ++size;
-      eval_expression(j,context);
-      j=nodes[j].bro;
+    bool cached;
+    Program* program=get_program(cmd,cached);
+    try{
+      result=run(*program,context);
     }
-    switch(node.expressionType){
-    case expFunction:
-      context.eval_function(node,nodes);
-      break;
-    case expMemberFunction:
-      context.eval_member_function(node,nodes);
-      break;
-    case expMemberSymbol:
-      context.eval_member_symbol(node,nodes);
-      break;
-    case expArray:
-      context.eval_array(size,node,nodes);
-      break;
-    case expSet:
-      context.eval_set(size,node,nodes);
-      break;
-    case expTuple:
-      context.eval_tuple(size,node,nodes);
-      break;
-    case expArrayGet:
-      Bug("Exp array get not yet implemented");
-      break;
-    default:
-      Bug("Not yet implemented");
-    }
-    j=node.son;
-    while(j!=-1){
-      nodes[j].value.pdel();
-      j=nodes[j].bro;
+    catch(...){
+      if(not cached) delete program;
+      throw;
     }
+    if(not cached) delete program;
+    return &result;
   }
 
   //-------------------------------------------------
   // Interpreter::get_integer(size_t&,const string&)
   //-------------------------------------------------
   
-  fmpz*
+  void*
   Interpreter::get_integer(size_t& pos,const string& cmd){
     size_t oldPos=pos;
     size_t end=cmd.length();
@@ -1334,11 +1316,17 @@ namespace Gomu{
     do{
       l=cmd[++pos];
     }while(pos<end and '0'<=l and l<='9');
+    //Integers with at most 18 digits are immediate
+    if(pos-oldPos<=18){
+      slong n=0;
+      for(size_t i=oldPos;i<pos;++i) n=10*n+(cmd[i]-'0');
+      return to_small_integer(n);
+    }
     string sint=cmd.substr(oldPos,pos-oldPos);
     fmpz* res=new fmpz;
     fmpz_init(res);
     fmpz_set_str(res,sint.c_str(),10);
-    return res;
+    return to_integer_fmpz(res);
   }
 
   //----------------------------------------------
@@ -1362,6 +1350,47 @@ namespace Gomu{
     return str;
   }
 
+  //-----------------------------------------------
+  // Interpreter::get_program(const string&,bool&)
+  //-----------------------------------------------
+
+  Program*
+  Interpreter::get_program(const string& cmd,bool& cached){
+    auto it=programs.find(cmd);
+    if(it!=programs.end() and not it->second->running){
+      cached=true;
+      return it->second;
+    }
+    split_to_tokens(cmd);
+    size_t first=0;
+    size_t root=construct_tree(first,nodes_number-1,max_precedence_level);
+    Program* program=new Program;
+    //Operands point to slots, which must therefore never be reallocated
+    program->slots.reserve(nodes_number+1);
+    try{
+      compile(root,*program);
+    }
+    catch(...){
+      delete program;
+      throw;
+    }
+    //A running program with the same text is a recursive call, the new
+    //program is then owned by the caller
+    cached=(it==programs.end());
+    if(not cached) return program;
+    if(programs.size()>=max_programs_number){
+      for(it=programs.begin();it!=programs.end();){
+	if(it->second->running) ++it;
+	else{
+	  delete it->second;
+	  it=programs.erase(it);
+	}
+      }
+    }
+    programs[cmd]=program;
+    return program;
+  }
+
   //------------------------------------------------
   // Interpreter::get_string(size_t&,const string&)
   //------------------------------------------------
@@ -1388,6 +1417,82 @@ namespace Gomu{
     }
   }
 
+  //-------------------------------------
+  // Interpreter::run(Program&,Context&)
+  //-------------------------------------
+
+  Value
+  Interpreter::run(Program& program,Context& context){
+    //Names are resolved once in the symbol table of the context
+    if(program.context!=&context){
+      program.ids.resize(program.names.size());
+      for(size_t i=0;i<program.names.size();++i){
+	program.ids[i]=context.table.intern(program.names[i]);
+      }
+      program.context=&context;
+    }
+    program.running=true;
+    try{
+      for(size_t i=0;i<program.code.size();++i){
+	const Instruction& ins=program.code[i];
+	Value** operands=program.operands.data()+ins.first;
+	Value& res=program.slots[i];
+	switch(ins.type){
+	case insConstant:{
+	  //Called functions may steal the value, so we give them a copy
+	  const Value& constant=program.constants[ins.index];
+	  res.type=constant.type;
+	  res.ptr=(constant.ptr==nullptr)?nullptr:constant.type->copy(constant.ptr);
+	  break;
+	}
+	case insSymbol:{
+	  Symbol* symbol=context.get_symbol(program.ids[ins.index]);
+	  if(symbol==nullptr) symbol=context.add_symbol(program.names[ins.index],type_void,nullptr,false);
+	  res.type=type_symbol;
+	  res.ptr=symbol;
+	  break;
+	}
+	case insFunction:
+	case insMemberFunction:{
+	  //Arguments may be redirected by the call, operands must be preserved
+	  Value* args[max_arguments_number];
+	  for(size_t k=0;k<ins.size;++k) args[k]=operands[k];
+	  if(ins.type==insFunction) res=context.eval_function(program.ids[ins.index],args,ins.size);
+	  else res=context.eval_member_function(program.ids[ins.index],args,ins.size);
+	  break;
+	}
+	case insMemberSymbol:
+	  //The unique operand is the symbol of the class or of the object
+	  res=context.eval_member_symbol((Symbol*)operands[0]->ptr,program.ids[ins.index]);
+	  break;
+	case insArray:
+	  res=context.eval_array(operands,ins.size);
+	  break;
+	case insSet:
+	  res=context.eval_set(operands,ins.size);
+	  break;
+	case insTuple:
+	  res=context.eval_tuple(operands,ins.size);
+	  break;
+	default:
+	  Bug("Instruction type unkown");
+	}
+	for(size_t k=0;k<ins.size;++k){
+	  operands[k]->pdel();
+	}
+      }
+    }
+    catch(...){
+      program.purge();
+      program.running=false;
+      throw;
+    }
+    Value res=program.slots.back();
+    program.slots.back().ptr=nullptr;
+    program.running=false;
+    return res;
+  }
+
   //-----------------------------------------------------
   // Interpreter::set_token(Node&,size_t&,const string&)
   //-----------------------------------------------------
@@ -1500,6 +1605,110 @@ namespace Gomu{
     --nodes_number;
   }
   
+  //***********
+  //* Program *
+  //***********
+
+  //---------------------
+  // Program::~Program()
+  //---------------------
+
+  Program::~Program(){
+    purge();
+    for(size_t i=0;i<constants.size();++i){
+      constants[i].pdel();
+    }
+  }
+
+  //------------------------------------------------------------------------
+  // Program::add_instruction(InstructionType,size_t,const vector<size_t>&)
+  //------------------------------------------------------------------------
+
+  size_t
+  Program::add_instruction(InstructionType type,size_t index,const vector<size_t>& args){
+    Instruction instruction;
+    instruction.type=type;
+    instruction.index=index;
+    instruction.first=operands.size();
+    instruction.size=args.size();
+    for(size_t i=0;i<args.size();++i){
+      operands.push_back(&slots[args[i]]);
+    }
+    code.push_back(instruction);
+    slots.push_back(Value());
+    return slots.size()-1;
+  }
+
+  //***************
+  //* SymbolTable *
+  //***************
+
+  //----------------------------------
+  // SymbolTable::find(const string&)
+  //----------------------------------
+
+  size_t
+  SymbolTable::find(const string& name) const{
+    size_t mask=buckets.size()-1;
+    for(size_t i=hash(name.data(),name.size())&mask;buckets[i]!=0;i=(i+1)&mask){
+      if(names[buckets[i]-1]==name) return buckets[i]-1;
+    }
+    return npos;
+  }
+
+  //------------------------------------------------
+  // SymbolTable::find(const string&,const string&)
+  //------------------------------------------------
+
+  size_t
+  SymbolTable::find(const string& prefix,const string& name) const{
+    size_t p=prefix.size();
+    size_t size=p+1+name.size();
+    uint64_t h=hash(name.data(),name.size(),hash(".",1,hash(prefix.data(),p)));
+    size_t mask=buckets.size()-1;
+    for(size_t i=h&mask;buckets[i]!=0;i=(i+1)&mask){
+      const string& str=names[buckets[i]-1];
+      if(str.size()==size and str[p]=='.' and str.compare(0,p,prefix)==0 and str.compare(p+1,string::npos,name)==0)
+	return buckets[i]-1;
+    }
+    return npos;
+  }
+
+  //---------------------
+  // SymbolTable::grow()
+  //---------------------
+
+  void
+  SymbolTable::grow(){
+    buckets.assign(2*buckets.size(),0);
+    size_t mask=buckets.size()-1;
+    for(size_t id=0;id<names.size();++id){
+      size_t i=hash(names[id].data(),names[id].size())&mask;
+      while(buckets[i]!=0) i=(i+1)&mask;
+      buckets[i]=id+1;
+    }
+  }
+
+  //------------------------------------
+  // SymbolTable::intern(const string&)
+  //------------------------------------
+
+  size_t
+  SymbolTable::intern(const string& name){
+    size_t id=find(name);
+    if(id!=npos) return id;
+    //Keep the load factor under one half
+    if(2*(names.size()+1)>buckets.size()) grow();
+    id=names.size();
+    names.push_back(name);
+    symbols.push_back(nullptr);
+    size_t mask=buckets.size()-1;
+    size_t i=hash(name.data(),name.size())&mask;
+    while(buckets[i]!=0) i=(i+1)&mask;
+    buckets[i]=id+1;
+    return id;
+  }
+
   //***********************
   //* Auxiliary functions *
   //***********************
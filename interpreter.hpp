@@ -24,6 +24,7 @@
 #include <deque>
 #include <map>
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include <dlfcn.h>
 #include <initializer_list>
@@ -43,6 +44,8 @@ namespace Gomu{
   static const int max_precedence_level=99;
   static const size_t max_nodes_number=1024;
   static const size_t max_arguments_number=8;
+  static const size_t max_programs_number=4096;
+  static const size_t dispatch_cache_size=8;
 
   //**********************
   //* Early declarations *
@@ -51,11 +54,15 @@ namespace Gomu{
   class Completion;
   class Context;
   class ContextualFunction;
+  class DispatchEntry;
   class Function;
+  class Instruction;
   class Node;
   class Interpreter;
   class OperatorInfo; 
+  class Program;
   class Symbol;
+  class SymbolTable;
   
   //************
   //* Typedefs *
@@ -109,6 +116,18 @@ namespace Gomu{
     expSet
   } ExpressionType;
 
+  //! Enumeration of instruction types
+  typedef enum{
+    insArray,
+    insConstant,
+    insFunction,
+    insMemberFunction,
+    insMemberSymbol,
+    insSet,
+    insSymbol,
+    insTuple
+  } InstructionType;
+
   //! Enumeration of token types
   typedef enum{
     tCloseBracket,
@@ -155,6 +174,52 @@ namespace Gomu{
     map<string,Symbol>::iterator it;
   };
 
+  //-------------
+  // SymbolTable
+  //-------------
+
+  //! Table of interned names. Each name has an integer id given at its
+  //! first insertion and found by an open addressing hash lookup. Ids
+  //! index the symbols named by them.
+  class SymbolTable{
+  public:
+    //! Hash buckets containing id+1 of a name, 0 for an empty bucket
+    vector<uint32_t> buckets;
+    //! Interned names indexed by id
+    vector<string> names;
+    //! Symbols indexed by id, nullptr if there is no symbol with this name
+    vector<Symbol*> symbols;
+
+    //! Id returned for a name not in the table
+    static const size_t npos=(size_t)-1;
+
+    //! The unique constructor
+    SymbolTable();
+
+    //! Return the id of name
+    //! \param name name to find
+    //! \return id of the name if it is interned, npos otherwise
+    size_t find(const string& name) const;
+
+    //! Return the id of the name prefix.name without building it
+    //! \param prefix part before the dot
+    //! \param name part after the dot
+    //! \return id of the name if it is interned, npos otherwise
+    size_t find(const string& prefix,const string& name) const;
+
+    //! Return the id of name, interning it if needed
+    //! \param name name to intern
+    //! \return id of the name
+    size_t intern(const string& name);
+
+  private:
+    //! Double the number of buckets and rehash names
+    void grow();
+
+    //! FNV-1a hash of size bytes of str, continuing the hash h
+    static uint64_t hash(const char* str,size_t size,uint64_t h=14695981039346656037ULL);
+  };
+
   //---------
   // Context
   //---------
@@ -165,8 +230,13 @@ namespace Gomu{
     //! Pointer to an interpreter
     Interpreter* interpreter;
     
-    //! Map for association name <-> symbol
+    //! Map for association name <-> symbol, sorted for completion
     map<string,Symbol> symbols;
+    //! Interned names giving hashed access to symbols
+    SymbolTable table;
+    //! Member tables of types, members[type][id] being the symbol
+    //! type.name where id is the id of name. Filled at first lookup.
+    unordered_map<Type*,vector<Symbol*>> members;
     
     //! The unique constructor
     Context(Interpreter* interpreter);
@@ -222,11 +292,11 @@ namespace Gomu{
     //! \return true if we can add the symbol false otherwise
     bool can_add_member_function(string name,string_list targs);
 
-    //! Evaluate an array node
+    //! Evaluate an array
+    //! \param args values of the array elements
     //! \param size size of the array
-    //! \param current the node of the array
-    //! \param nodes array of all nodes
-    void eval_array(size_t size,Node& current,Node* nodes);
+    //! \return the array value
+    Value eval_array(Value** args,size_t size);
 
     //! Evaluate a contextual function
     //! \param contextual pointer to a contextual function
@@ -242,11 +312,12 @@ namespace Gomu{
     //! \return value returned by the function
     Value eval_function(Function* function,Value** args,size_t nargs);
 
-    //! Evaluate a function node (contextual or not)
-    //! \param current the node of the function to evaluate
-    //! \param nodes array of all nodes
-    //! \param size size of the array
-    void eval_function(Node& current,Node* nodes);
+    //! Evaluate a function given by its name id (contextual or not)
+    //! \param id id of the function name
+    //! \param args arguments of the function call
+    //! \param nargs number of argument for the function call
+    //! \return value returned by the function
+    Value eval_function(size_t id,Value** args,size_t nargs);
     
     //! Evaluate a function given by a symbol (contextual or not)
     //! \param symbol symbol for the function
@@ -255,27 +326,30 @@ namespace Gomu{
     //! \return value returned by the function
     Value eval_function(Symbol* symbol,Value** args,size_t nargs);
     
-    //! Evaluate a member function node (contextual or not)
-    //! \param current the node of the function to evaluate
-    //! \param nodes array of all nodes
-     void eval_member_function(Node& current,Node* nodes);
+    //! Evaluate a member function (contextual or not)
+    //! \param id id of the member function name
+    //! \param args arguments of the function call, the first one being the object
+    //! \param nargs number of argument for the function call
+    //! \return value returned by the function
+    Value eval_member_function(size_t id,Value** args,size_t nargs);
 
     //! Evaluate a member symbol
-    //! \param current the node of the symbol to evaluate
-    //! \param nodes array of all nodes
-    void eval_member_symbol(Node& current,Node* nodes);
+    //! \param symbol the object or the type owning the member
+    //! \param id id of the member name
+    //! \return the symbolic value of the member
+    Value eval_member_symbol(Symbol* symbol,size_t id);
     
-    //! Evaluate a set node
+    //! Evaluate a set
+    //! \param args values of the set elements
     //! \param size size of the set
-    //! \param current the node of the set
-    //! \param nodes array of all nodes
-    void eval_set(size_t size,Node& current,Node* nodes);
+    //! \return the set value
+    Value eval_set(Value** args,size_t size);
  
-    //! Evaluate a tuple node
+    //! Evaluate a tuple
+    //! \param args values of the tuple elements
     //! \param size size of the tuple
-    //! \param current the node of the tuple
-    //! \param nodes array of all nodes
-    void eval_tuple(size_t size,Node& current,Node* nodes);
+    //! \return the tuple value
+    Value eval_tuple(Value** args,size_t size);
 
     //! Return the signature of a string list of arguments
     //! \param args the string list
@@ -285,13 +359,24 @@ namespace Gomu{
     //! Return the symbol named name
     //! \param name name to find
     //! \return Symbol corresponding to name if it exists, nullptr otherwise
-    Symbol* get_symbol(string name);
+    Symbol* get_symbol(const string& name);
+
+    //! Return the symbol whose name has a given id
+    //! \param id id of the name
+    //! \return Symbol corresponding to id if it exists, nullptr otherwise
+    Symbol* get_symbol(size_t id);
     
     //! Return the symbol named name in class type
     //! \param ctype type to lookup
     //! \param name name to find
     //! \return Symbol corresponding to name if it exists, nullptr otherwise
-    Symbol* get_symbol(Type* ctype,string name);
+    Symbol* get_symbol(Type* ctype,const string& name);
+
+    //! Return the symbol named name in class type using member tables
+    //! \param ctype type to lookup
+    //! \param id id of the name to find
+    //! \return Symbol corresponding to name if it exists, nullptr otherwise
+    Symbol* get_symbol(Type* ctype,size_t id);
     
     //! Return the type named name
     //! \param name name to find
@@ -335,13 +420,6 @@ namespace Gomu{
     //! Reload a module
     //! \param module the module to reload
     void reload_module(Module* module);
-
-    //! Set arguments of a function node
-    //! \param current node of the function to consider
-    //! \param nodes an array of all nodes
-    //! \args an array of Value* to store the arguments of the function
-    //! \return number of arguments of the function call
-    size_t set_arguments(Node& current,Node* nodes,Value** args);
   };
 
   //--------------------
@@ -371,6 +449,23 @@ namespace Gomu{
     Value eval(Value* args[8],size_t nargs,Context& context);
   };
 
+  //---------------
+  // DispatchEntry
+  //---------------
+
+  //! Entry of the dispatch cache of a meta function
+  class DispatchEntry{
+
+  public:
+
+    //! Number of arguments
+    size_t nargs;
+    //! Types of arguments
+    Type* types[max_arguments_number];
+    //! Function called for these argument types
+    Function* function;
+  };
+
   //----------
   // Function
   //----------
@@ -398,6 +493,25 @@ namespace Gomu{
     Value eval(Value* args[8],size_t nargs);
   };
 
+  //-------------
+  // Instruction
+  //-------------
+
+  //! Class for bytecode instruction
+  class Instruction{
+
+  public:
+
+    //! Type of the instruction
+    InstructionType type;
+    //! Index of the name or of the constant used by the instruction in the program
+    uint32_t index;
+    //! Index of the first operand in the operand array of the program
+    uint32_t first;
+    //! Number of operands
+    uint32_t size;
+  };
+
   //------
   // Node
   //------
@@ -448,11 +562,18 @@ namespace Gomu{
     Node nodes[max_nodes_number];
     //! The dictionnary of all defined operator
     Dictionnary<OperatorInfo> operator_tree;
+    //! Compiled commands indexed by their text
+    unordered_map<string,Program*> programs;
+    //! Value of the last command evaluated by eval_basic
+    Value result;
     
   public:
     
     //! The unique constructor
     Interpreter();
+
+    //! Destructor
+    ~Interpreter();
     
     //! Add an operator to the operator's dictionnary
     //! \param op operator identification (=,!=,...)
@@ -471,6 +592,12 @@ namespace Gomu{
     //! \return a possible completion or ""
     string complete(const string& cmd,const string& word,size_t pos,int state,Context& context);
 
+    //! Compile an expression tree into a program
+    //! \param pos position of the tree root
+    //! \param program destination program
+    //! \return index of the slot receiving the value of the expression
+    size_t compile(size_t pos,Program& program);
+
     //! Construct a sequence from an expression
     //! \param first position of the first node of the sequence
     //! \param last position of the last node of the sequence
@@ -504,21 +631,18 @@ namespace Gomu{
     //! \param display specify if we display the last value
     void eval(string cmd,Context& context);
 
-    //! Evaluate a command in very basic way
+    //! Evaluate a command in very basic way. The command is compiled once
+    //! into a program which is cached and run at each call.
     //! \param cmd the check command
     //! \param context context of the evaluation
+    //! \return value of the command, to be deleted by the caller
     Value* eval_basic(string cmd,Context& context);
 
-    //! Evaluate an expression
-    //! \param pos indice of the expression to evaluate
-    //! \param context context of the evaluation
-    void eval_expression(size_t pos,Context& context);
-
     //! Get an integer from a substring of a command
     //! \param pos indice of the substring of the command representing the integer
     //! \param cmd command
     //! \return pointer to the corresponding integer
-    fmpz* get_integer(size_t& pos,const string& cmd);
+    void* get_integer(size_t& pos,const string& cmd);
 
     //! Get a name from a substring of a command
     //! \param pos indice of the substring of the command representing the name
@@ -526,6 +650,13 @@ namespace Gomu{
     //! \return name
     string get_name(size_t& pos,const string& cmd);
 
+    //! Return the program of a command. It is compiled only if it
+    //! is not in the cache or if the cached one is running.
+    //! \param cmd command
+    //! \param cached set to true if the returned program is owned by the cache
+    //! \return program of the command
+    Program* get_program(const string& cmd,bool& cached);
+
     //! Try to get an operator from a substring of a command
     //! \param pos indice of the substring of the command representing the operator
     //! \param cmd command
@@ -540,6 +671,12 @@ namespace Gomu{
 
     //! Purge the expression tree
     void purge_tree();
+
+    //! Run a program, values of its slots being deleted on exit
+    //! \param program program to run
+    //! \param context context of the evaluation
+    //! \return value of the last instruction
+    Value run(Program& program,Context& context);
     
     //! Set node to be the token of command at position pos
     //! \param node destination node of the token
@@ -561,6 +698,30 @@ namespace Gomu{
   public:
     //! Fullname of overloaded functions
     set<string> functions;
+    //! Functions resolved for the argument types of recent calls
+    DispatchEntry cache[dispatch_cache_size];
+    //! Number of used entries of the cache
+    size_t cache_size;
+    //! Entry replaced by the next insertion in a full cache
+    size_t cache_next;
+
+    //! The unique constructor
+    MetaFunction();
+
+    //! Add the function resolved for arguments to the cache
+    //! \param args arguments of the function call, which are not symbols
+    //! \param nargs number of arguments of the function call
+    //! \param function the function resolved for args
+    void add_to_cache(Value** args,size_t nargs,Function* function);
+
+    //! Clear the cache, must be called when overloaded functions change
+    void clear_cache();
+
+    //! Return the function cached for the argument types of a call
+    //! \param args arguments of the function call, which are not symbols
+    //! \param nargs number of arguments of the function call
+    //! \return the cached function, nullptr if there is none
+    Function* find_in_cache(Value** args,size_t nargs) const;
   };
    
   //--------------
@@ -582,6 +743,62 @@ namespace Gomu{
     OperatorInfo(string func,OperatorType t,int p);
   };
   
+  //---------
+  // Program
+  //---------
+
+  //! Class for compiled command. Instructions are stored in post order,
+  //! the value of the i-th one being written in the i-th slot. Operands
+  //! point directly to the slots of previous instructions.
+  class Program{
+
+  public:
+
+    //! Instructions
+    vector<Instruction> code;
+    //! Literal values of the command, copied at each run
+    vector<Value> constants;
+    //! Context in which names are resolved
+    Context* context;
+    //! Ids of names in the symbol table of the context
+    vector<size_t> ids;
+    //! Names of symbols and functions
+    vector<string> names;
+    //! Operands of instructions
+    vector<Value*> operands;
+    //! Specify if the program is running
+    bool running;
+    //! Values of instructions
+    vector<Value> slots;
+
+    //! The unique constructor
+    Program();
+
+    //! No copy constructor
+    Program(const Program&)=delete;
+
+    //! Destructor
+    ~Program();
+
+    //! Add an instruction whose operands are given by slots indices
+    //! \param type type of the instruction
+    //! \param index index of the name or of the constant
+    //! \param args slot indices of the operands
+    //! \return slot index of the instruction
+    size_t add_instruction(InstructionType type,size_t index,const vector<size_t>& args);
+
+    //! Add a name in the name array
+    //! \param name name to add
+    //! \return index of the name
+    size_t add_name(const string& name);
+
+    //! No copy assignment
+    Program& operator=(const Program&)=delete;
+
+    //! Delete values of slots
+    void purge();
+  };
+
   //--------
   // Symbol
   //--------
@@ -668,13 +885,21 @@ namespace Gomu{
   }
 
   inline Symbol*
-  Context::get_symbol(Type* ctype,string name){
-    return get_symbol(ctype->name+"."+name);
+  Context::get_symbol(const string& name){
+    size_t id=table.find(name);
+    return (id==SymbolTable::npos)?nullptr:table.symbols[id];
   }
 
-  inline void
-  Context::unload_symbol(string name){
-    symbols.erase(name);
+  inline Symbol*
+  Context::get_symbol(size_t id){
+    return table.symbols[id];
+  }
+
+  inline Symbol*
+  Context::get_symbol(Type* ctype,const string& name){
+    //A lookup must not intern the names it does not find
+    size_t id=table.find(ctype->name,name);
+    return (id==SymbolTable::npos)?nullptr:table.symbols[id];
   }
   
   //--------------------
@@ -693,7 +918,7 @@ namespace Gomu{
   Function::Function(Type* t,const Signature& s,void* p):tr(t),signature(s),ptr(p){
   }
 
-   //-------------
+  //-------------
   // Interpreter
   //-------------
   
@@ -703,6 +928,27 @@ namespace Gomu{
   inline OperatorInfo*
   Interpreter::get_operator(size_t& pos,const string& cmd){return operator_tree.find_at(pos,cmd);}
 
+  //---------
+  // Program
+  //---------
+
+  inline
+  Program::Program():context(nullptr),running(false){
+  }
+
+  inline size_t
+  Program::add_name(const string& name){
+    names.push_back(name);
+    return names.size()-1;
+  }
+
+  inline void
+  Program::purge(){
+    for(size_t i=0;i<slots.size();++i){
+      slots[i].pdel();
+    }
+  }
+
   //--------
   // Symbol
   //--------
@@ -711,6 +957,63 @@ namespace Gomu{
   Symbol::Symbol():Value(),locked(false){
   }
 
+  //-------------
+  // SymbolTable
+  //-------------
+
+  inline
+  SymbolTable::SymbolTable():buckets(64,0){
+  }
+
+  inline uint64_t
+  SymbolTable::hash(const char* str,size_t size,uint64_t h){
+    for(size_t i=0;i<size;++i){
+      h=(h^(unsigned char)str[i])*1099511628211ULL;
+    }
+    return h;
+  }
+
+  //--------------
+  // MetaFunction
+  //--------------
+
+  inline
+  MetaFunction::MetaFunction():cache_size(0),cache_next(0){
+  }
+
+  inline void
+  MetaFunction::add_to_cache(Value** args,size_t nargs,Function* function){
+    if(nargs>max_arguments_number) return;
+    size_t i;
+    if(cache_size<dispatch_cache_size) i=cache_size++;
+    else{
+      i=cache_next;
+      cache_next=(cache_next+1)%dispatch_cache_size;
+    }
+    DispatchEntry& entry=cache[i];
+    entry.nargs=nargs;
+    for(size_t k=0;k<nargs;++k) entry.types[k]=args[k]->type;
+    entry.function=function;
+  }
+
+  inline void
+  MetaFunction::clear_cache(){
+    cache_size=0;
+    cache_next=0;
+  }
+
+  inline Function*
+  MetaFunction::find_in_cache(Value** args,size_t nargs) const{
+    for(size_t i=0;i<cache_size;++i){
+      const DispatchEntry& entry=cache[i];
+      if(entry.nargs!=nargs) continue;
+      size_t k=0;
+      while(k<nargs and entry.types[k]==args[k]->type) ++k;
+      if(k==nargs) return entry.function;
+    }
+    return nullptr;
+  }
+
   //--------------
   // OperatorInfo
   //--------------
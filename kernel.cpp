@@ -137,6 +137,7 @@ namespace Gomu{
 
   string
   integer_disp(void* v){
+    if(is_small_integer(v)) return "\033[34m"+to_string(get_small_integer(v))+"\033[0m";
     char* disp=fmpz_get_str(NULL,10,(fmpz*)v);  
     string res="\033[34m";
     res+=disp;
@@ -147,6 +148,8 @@ namespace Gomu{
 
   void*
   integer_copy(void* v){
+    //Immediate integers are not pointers
+    if(is_small_integer(v)) return v;
     fmpz* res=new fmpz;
     fmpz_init_set(res,(fmpz*)v);
     return res;
@@ -317,7 +320,7 @@ namespace Gomu{
   //* Auxialiry functions *
   //***********************
 
-    //----------------------------------
+  //----------------------------------
   // disp_signature(const Signature&)
   //----------------------------------
   
@@ -351,6 +354,7 @@ namespace Gomu{
     interpreter.add_operator("*","operator*",opBinary,5);
     interpreter.add_operator("/","operator/",opBinary,5);
     interpreter.add_operator("%","operator%",opBinary,5);
+    interpreter.add_operator("^","operator^",opBinary,3);
     interpreter.add_operator("::","operator::",opBinary,1);
     interpreter.add_operator("!","factorial",opPostUnitary,2);
     context.add_contextual_function("Void","load",{"String"},(void*)load_module);
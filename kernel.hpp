@@ -179,12 +179,13 @@ namespace Gomu{
 
   //---------
   // Boolean
-  //----------
+  //---------
+  //Boolean payloads are the shared boolean_true and boolean_false
   inline void
-  boolean_del(void* v){delete (char*)v;}
+  boolean_del(void*){}
   
   inline void*
-  boolean_copy(void* v){return new char(*(char*)v);}
+  boolean_copy(void* v){return to_boolean(*(char*)v!=0);}
 
   //---------
   // Context
@@ -233,10 +234,29 @@ namespace Gomu{
   //---------
  
   inline void
-  integer_del(void* v){fmpz_clear((fmpz*)v);}
+  integer_del(void* v){
+    if(is_small_integer(v)) return;
+    fmpz_clear((fmpz*)v);
+    delete (fmpz*)v;
+  }
 
   inline int
-  integer_comp(void* v1,void* v2){return fmpz_cmp((fmpz*)v1,(fmpz*)v2);}
+  integer_comp(void* v1,void* v2){
+    if(is_small_integer(v1) and is_small_integer(v2)){
+      slong n1=get_small_integer(v1);
+      slong n2=get_small_integer(v2);
+      return (n1<n2)?-1:((n1==n2)?0:1);
+    }
+    fmpz z1,z2;
+    fmpz_init(&z1);
+    fmpz_init(&z2);
+    get_fmpz(&z1,v1);
+    get_fmpz(&z2,v2);
+    int res=fmpz_cmp(&z1,&z2);
+    fmpz_clear(&z1);
+    fmpz_clear(&z2);
+    return res;
+  }
   
   //--------------
   // MetaFunction
@@ -197,12 +197,23 @@ namespace Gomu{
   //* Auxiliary functions *
   //***********************
 
+  //-----------------------
+  // get_fmpz(fmpz*,void*)
+  //-----------------------
+
+  void
+  get_fmpz(fmpz* z,void* v){
+    if(is_small_integer(v)) fmpz_set_si(z,get_small_integer(v));
+    else fmpz_set(z,(fmpz*)v);
+  }
+
   //------------------
   // get_slong(void*)
   //------------------
   
   int64
   get_slong(void* v){
+    if(is_small_integer(v)) return get_small_integer(v);
     fmpz* z=(fmpz*)v;
     if(fmpz_fits_si(z)) return fmpz_get_si(z);
     else  RuntimeError("Integer too huge to fit slong");
@@ -214,9 +225,7 @@ namespace Gomu{
   
   void*
   to_boolean(bool b){
-    char* res=new char;
-    *res=(b?1:0);
-    return res;
+    return b?&boolean_true:&boolean_false;
   }
 
   //-------------------
@@ -225,12 +234,27 @@ namespace Gomu{
   
   void*
   to_integer(slong n){
+    if(small_integer_min<=n and n<=small_integer_max) return to_small_integer(n);
     fmpz* z=new fmpz;
     fmpz_init(z);
     fmpz_set_si(z,n);
     return z;
   }
 
+  //------------------------
+  // to_integer_fmpz(fmpz*)
+  //------------------------
+
+  void*
+  to_integer_fmpz(fmpz* z){
+    if(not fmpz_fits_si(z)) return z;
+    slong n=fmpz_get_si(z);
+    if(n<small_integer_min or n>small_integer_max) return z;
+    fmpz_clear(z);
+    delete z;
+    return to_small_integer(n);
+  }
+
   //----------------
   // no_copy(void*)
   //----------------
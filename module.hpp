@@ -88,6 +88,17 @@ namespace Gomu{
     errUnkown
   } ErrorType;
 
+  //*************
+  //* Constants *
+  //*************
+
+  //! Bounds of immediate integers. An Integer value ptr whose lowest bit
+  //! is set is not a pointer but stores the integer ptr>>1, the other ones
+  //! point to a heap allocated fmpz. Integers between these bounds are
+  //! always immediate.
+  static const slong small_integer_min=-(slong(1)<<62);
+  static const slong small_integer_max=(slong(1)<<62)-1;
+
   //******************
   //* Global objects *
   //******************
@@ -108,6 +119,10 @@ namespace Gomu{
   extern Type *type_type;
   extern Type *type_void;
 
+  //! Shared payloads of Boolean values, which are never deleted
+  extern char boolean_false;
+  extern char boolean_true;
+
   //**********************
   //* Class declarations *
   //**********************
@@ -420,15 +435,32 @@ namespace Gomu{
   //* Auxiliary functions *
   //***********************
 
+  //! Set z, which must be initialised, to the integer of a value ptr
+  void get_fmpz(fmpz* z,void* v);
+
   //! Return an slong from a value ptr
   int64 get_slong(void* v);
+
+  //! Return the integer of an immediate integer value ptr
+  slong get_small_integer(void* v);
+
+  //! Test if an integer value ptr is immediate
+  bool is_small_integer(void* v);
   
-  //! Return a value ptr for a bool 
+  //! Return the shared value ptr of a bool
   void* to_boolean(bool n);
 
   //! Return a value ptr from a slong integer
   void* to_integer(slong s);
 
+  //! Return a value ptr from a heap allocated fmpz, which is freed if the
+  //! integer can be immediate
+  void* to_integer_fmpz(fmpz* z);
+
+  //! Return the immediate integer value ptr of n, which must be between
+  //! small_integer_min and small_integer_max
+  void* to_small_integer(slong n);
+
   //! Undefined copy function for type
   void* no_copy(void*);
 
@@ -462,6 +494,25 @@ namespace Gomu{
   inline
   Module::~Module(){}
 
+  //----------------
+  // Small integers
+  //----------------
+
+  inline slong
+  get_small_integer(void* v){
+    return ((intptr_t)v)>>1;
+  }
+
+  inline bool
+  is_small_integer(void* v){
+    return ((uintptr_t)v)&1;
+  }
+
+  inline void*
+  to_small_integer(slong n){
+    return (void*)((((uintptr_t)n)<<1)|1);
+  }
+
   //--------------
   // SetValueComp
   //--------------